@@ -0,0 +1,133 @@
+#ifndef ALE_DATAVIEW_H
+#define ALE_DATAVIEW_H
+
+#include <cstddef>
+#include <vector>
+
+namespace ale {
+
+  /**
+   * A non-owning view of an array of doubles.
+   *
+   * The elements of the view can be spaced out in memory, so a view can cover
+   * a single column of a row-major table, such as an (n, 3) numpy array. The
+   * viewed memory must outlive the view.
+   */
+  class DataView {
+    public:
+      /**
+       * Construct a view of an array.
+       *
+       * @param data Pointer to the first element.
+       * @param size The number of elements in the view.
+       * @param stride The distance between consecutive elements, in doubles.
+       */
+      DataView(const double *data, size_t size, size_t stride = 1) :
+            m_data(data), m_size(size), m_stride(stride) { }
+
+      /**
+       * Construct a view of a vector.
+       *
+       * The view points into the vector, so the vector must outlive the view
+       * and anything that keeps it, like an Interpolator built from views.
+       *
+       * @param vec The vector to view.
+       */
+      DataView(const std::vector<double> &vec) :
+            m_data(vec.data()), m_size(vec.size()), m_stride(1) { }
+
+      // A view of a temporary vector would dangle as soon as the vector is gone
+      DataView(std::vector<double> &&vec) = delete;
+
+      const double &operator[](size_t index) const {
+        return m_data[index * m_stride];
+      }
+
+      const double &front() const {
+        return m_data[0];
+      }
+
+      const double &back() const {
+        return m_data[(m_size - 1) * m_stride];
+      }
+
+      const double *data() const {
+        return m_data;
+      }
+
+      size_t size() const {
+        return m_size;
+      }
+
+      size_t stride() const {
+        return m_stride;
+      }
+
+      /**
+       * If the elements of the view are next to each other in memory.
+       */
+      bool contiguous() const {
+        return m_stride == 1;
+      }
+
+    private:
+      const double *m_data;
+      size_t m_size;
+      size_t m_stride;
+  };
+
+  /**
+   * A non-owning view of a set of components sampled at a set of times.
+   *
+   * Element (i, j) is component i at sample j, matching the layout of the
+   * vector of vectors accepted by functions like getPosition. The strides
+   * between components and between samples are independent, so both row-major
+   * and column-major tables can be viewed without copying. For example, an
+   * (n, 3) row-major array of positions is viewed with a component stride of 1
+   * and a sample stride of 3.
+   */
+  class MatrixView {
+    public:
+      /**
+       * Construct a view of a table.
+       *
+       * @param data Pointer to the first element.
+       * @param numComponents The number of components.
+       * @param numSamples The number of samples of each component.
+       * @param componentStride The distance between components, in doubles.
+       * @param sampleStride The distance between samples, in doubles.
+       */
+      MatrixView(const double *data, size_t numComponents, size_t numSamples,
+                 size_t componentStride, size_t sampleStride) :
+            m_data(data), m_numComponents(numComponents), m_numSamples(numSamples),
+            m_componentStride(componentStride), m_sampleStride(sampleStride) { }
+
+      double operator()(size_t component, size_t sample) const {
+        return m_data[component * m_componentStride + sample * m_sampleStride];
+      }
+
+      /**
+       * View all of the samples of a single component.
+       */
+      DataView component(size_t index) const {
+        return DataView(m_data + index * m_componentStride, m_numSamples, m_sampleStride);
+      }
+
+      size_t numComponents() const {
+        return m_numComponents;
+      }
+
+      size_t numSamples() const {
+        return m_numSamples;
+      }
+
+    private:
+      const double *m_data;
+      size_t m_numComponents;
+      size_t m_numSamples;
+      size_t m_componentStride;
+      size_t m_sampleStride;
+  };
+}
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef ALE_FRAMECHAIN_H
+#define ALE_FRAMECHAIN_H
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Rotation.h"
+
+namespace ale {
+
+  /**
+   * The rotation from one reference frame to another, either constant or
+   * time dependent.
+   */
+  class FrameRotation {
+    public:
+      /**
+       * Construct a constant rotation.
+       */
+      explicit FrameRotation(const Rotation& rotation = Rotation());
+      /**
+       * Construct a time dependent rotation.
+       */
+      explicit FrameRotation(const TimeDependentRotation& rotation);
+
+      bool isTimeDependent() const {
+        return static_cast<bool>(m_timeDependent);
+      }
+
+      /**
+       * The constant rotation. Only valid if the rotation is not time dependent.
+       */
+      const Rotation& constantRotation() const {
+        return m_constant;
+      }
+
+      /**
+       * The time dependent rotation. Only valid if the rotation is time dependent.
+       */
+      const TimeDependentRotation& timeDependentRotation() const {
+        return *m_timeDependent;
+      }
+
+      /**
+       * Get the inverse rotation.
+       */
+      FrameRotation inverse() const;
+
+      /**
+       * Chain this rotation with another rotation.
+       *
+       * Rotations are sequenced right to left. The result is only constant
+       * if both rotations are.
+       */
+      FrameRotation operator*(const FrameRotation& rightRotation) const;
+
+    private:
+      Rotation m_constant;
+      // Shared so that copies of a time dependent rotation are cheap
+      std::shared_ptr<const TimeDependentRotation> m_timeDependent;
+  };
+
+  /**
+   * A graph of rotations between reference frames.
+   *
+   * Frames are identified by their NAIF codes, and each rotation connects two
+   * frames in both directions. This is the native version of
+   * ale.transformation.FrameChain.
+   *
+   * The rotation between two frames is chained along the shortest path
+   * between them. Runs of constant rotations along the path are multiplied
+   * together before they are applied to a time dependent rotation, so each
+   * run costs a single pass over the times. Every chained rotation is
+   * remembered, so asking for the same pair of frames again is a lookup.
+   */
+  class FrameChain {
+    public:
+      /**
+       * Add a constant rotation between two frames.
+       *
+       * @param source The frame that the rotation rotates from.
+       * @param destination The frame that the rotation rotates to.
+       * @param rotation The rotation.
+       */
+      void addRotation(int source, int destination, const Rotation& rotation);
+
+      /**
+       * Add a time dependent rotation between two frames.
+       *
+       * @param source The frame that the rotation rotates from.
+       * @param destination The frame that the rotation rotates to.
+       * @param rotation The rotation.
+       */
+      void addRotation(int source, int destination, const TimeDependentRotation& rotation);
+
+      /**
+       * If a frame has any rotations.
+       */
+      bool hasFrame(int frame) const {
+        return m_edges.count(frame) > 0;
+      }
+
+      /**
+       * Find the shortest path of frames between two frames.
+       *
+       * @param source The frame to start from.
+       * @param destination The frame to end at.
+       *
+       * @return The frames along the path, starting with source and ending
+       *         with destination.
+       */
+      std::vector<int> framePath(int source, int destination) const;
+
+      /**
+       * Get the rotation from one frame to another.
+       *
+       * @param source The frame to rotate from.
+       * @param destination The frame to rotate to.
+       *
+       * @return The rotation, which stays valid until another rotation is
+       *         added. If the frames are the same, this is the identity.
+       */
+      const FrameRotation& rotation(int source, int destination);
+
+    private:
+      // A rotation to a neighboring frame
+      struct Edge {
+        int destination;
+        FrameRotation rotation;
+      };
+
+      // Add a rotation in one direction
+      void addEdge(int source, int destination, const FrameRotation& rotation);
+
+      // Find the rotation directly between two neighboring frames
+      const FrameRotation& edgeRotation(int source, int destination) const;
+
+      // The rotations from each frame to its neighbors
+      std::map<int, std::vector<Edge>> m_edges;
+      // The chained rotations that have already been asked for
+      std::map<std::pair<int, int>, FrameRotation> m_rotations;
+  };
+}
+
+#endif
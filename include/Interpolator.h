@@ -0,0 +1,119 @@
+#ifndef ALE_INTERPOLATOR_H
+#define ALE_INTERPOLATOR_H
+
+#include <memory>
+#include <vector>
+
+#include "DataView.h"
+
+namespace ale {
+
+  /// Interpolation enum for defining different methods of interpolation
+  enum interpolation {
+    /// Interpolate using linear interpolation
+    linear,
+    /// Interpolate using spline interpolation
+    spline,
+    /// Interpolate using cubic Hermite interpolation over values and first
+    /// derivatives. Only available where derivatives are provided, such as a
+    /// StateTable with velocities.
+    hermite,
+    /// Interpolate using Lagrange polynomials through a window of up to eight
+    /// points centered on the interval being evaluated
+    lagrange
+  };
+
+  /**
+   * A prepared interpolation over a set of points and their associated times.
+   *
+   * The interpolation is built once when the interpolator is constructed and
+   * can then be evaluated at any number of times. The interval search hunts
+   * outward from the last interval found, so evaluating at nearby times is
+   * cheap.
+   */
+  class Interpolator {
+    public:
+      /**
+       * Construct an interpolator over a set of points.
+       *
+       * @param points The values to interpolate over.
+       * @param times The time of each value. Must be sorted in ascending order.
+       * @param interp The type of interpolation to use.
+       */
+      Interpolator(const std::vector<double>& points,
+                   const std::vector<double>& times,
+                   interpolation interp);
+      /**
+       * Construct an interpolator over a view of a set of points.
+       *
+       * Contiguous views are interpolated in place without being copied, so
+       * the viewed memory must outlive the interpolator. Views with a stride
+       * are copied because the interpolation requires contiguous arrays.
+       *
+       * @param points The values to interpolate over.
+       * @param times The time of each value. Must be sorted in ascending order.
+       * @param interp The type of interpolation to use.
+       */
+      Interpolator(const DataView& points,
+                   const DataView& times,
+                   interpolation interp);
+      ~Interpolator();
+
+      // Special member functions
+      Interpolator(Interpolator && other) noexcept;
+      Interpolator& operator=(Interpolator && other) noexcept;
+
+      /**
+       * Evaluate the interpolation at a time.
+       *
+       * @param time The time to evaluate at. Must be within the input times.
+       * @param d The order of the derivative to evaluate (0, 1, or 2).
+       *
+       * @return The interpolated value or derivative.
+       */
+      double eval(double time, int d = 0);
+
+      /**
+       * Evaluate the interpolation at a set of times.
+       *
+       * The interval search is carried over from each time to the next, so
+       * sorted times are the cheapest to evaluate.
+       *
+       * @param times The times to evaluate at. Must be within the input times.
+       * @param numTimes The number of times to evaluate at.
+       * @param d The order of the derivative to evaluate (0, 1, or 2).
+       * @param values Output array for the interpolated values or derivatives.
+       *               Must hold numTimes values.
+       */
+      void eval(const double *times, size_t numTimes, int d, double *values);
+
+      /**
+       * Evaluate the interpolation at a sorted set of times.
+       *
+       * The interval search only moves forward from each time to the next, so
+       * walking the whole interpolation costs amortized O(1) per time. Only the
+       * first and last times are range checked.
+       *
+       * @param times The times to evaluate at. Must be sorted in ascending
+       *              order and within the input times.
+       * @param numTimes The number of times to evaluate at.
+       * @param d The order of the derivative to evaluate (0, 1, or 2).
+       * @param values Output array for the interpolated values or derivatives.
+       *               Must hold numTimes values.
+       */
+      void sweep(const double *times, size_t numTimes, int d, double *values);
+
+      /**
+       * The number of points being interpolated over.
+       */
+      size_t size() const;
+
+    private:
+      // Implementation class
+      class Impl;
+      // Pointer to internal interpolation implementation.
+      std::unique_ptr<Impl> m_impl;
+  };
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef ALE_INTERVALCURSOR_H
+#define ALE_INTERVALCURSOR_H
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ale {
+
+  /**
+   * A persistent position in a sorted array of times.
+   *
+   * The cursor remembers the last interval it found and hunts outward from
+   * it, checking intervals at exponentially growing distances before doing a
+   * binary search over the bracketed range. Finding a time near the last one
+   * costs O(1), and walking a sorted set of query times across the whole
+   * array costs amortized O(1) per query instead of a full O(log n) search.
+   * A time in the same interval as the last one is found with a single pair
+   * of compares.
+   */
+  class IntervalCursor {
+    public:
+      IntervalCursor() : m_interval(0) { }
+
+      /**
+       * Find the interval that contains a time.
+       *
+       * @param times The sorted times. Must have at least two times.
+       * @param size The number of times.
+       * @param time The time to find.
+       *
+       * @return The largest index i in [0, size - 2] such that times[i] <= time,
+       *         or 0 if time is before every time.
+       */
+      size_t find(const double *times, size_t size, double time) {
+        size_t last = size - 2;
+        size_t lo = std::min(m_interval, last);
+        // Dense queries usually land in the same interval as the last one
+        if (time >= times[lo] && (lo == last || time < times[lo + 1])) {
+          return lo;
+        }
+        if (time < times[lo]) {
+          // Hunt backwards
+          size_t hi = lo;
+          size_t step = 1;
+          while (lo > 0 && time < times[lo]) {
+            hi = lo;
+            lo = (lo > step) ? lo - step : 0;
+            step *= 2;
+          }
+          m_interval = search(times, lo, hi, time);
+          return m_interval;
+        }
+        m_interval = lo;
+        return advance(times, size, time);
+      }
+
+      /**
+       * Find the interval that contains a time, only searching forward from
+       * the last interval. Use this when walking a sorted set of times.
+       *
+       * @param times The sorted times. Must have at least two times.
+       * @param size The number of times.
+       * @param time The time to find. Must not be before the start of the
+       *             last interval that was found.
+       *
+       * @return The largest index i in [0, size - 2] such that times[i] <= time.
+       */
+      size_t advance(const double *times, size_t size, double time) {
+        size_t last = size - 2;
+        size_t lo = std::min(m_interval, last);
+        if (lo < last && time >= times[lo + 1]) {
+          // Hunt forwards
+          size_t hi = lo + 1;
+          size_t step = 1;
+          while (hi <= last && time >= times[hi]) {
+            lo = hi;
+            hi = std::min(hi + step, last + 1);
+            step *= 2;
+          }
+          lo = (time >= times[hi]) ? last : search(times, lo, hi, time);
+        }
+        m_interval = lo;
+        return m_interval;
+      }
+
+      /**
+       * The last interval that was found.
+       */
+      size_t interval() const {
+        return m_interval;
+      }
+
+      /**
+       * Move the cursor back to the first interval.
+       */
+      void reset() {
+        m_interval = 0;
+      }
+
+    private:
+      // Binary search for the interval containing a time, given that
+      // times[lo] <= time < times[hi] or lo is 0.
+      static size_t search(const double *times, size_t lo, size_t hi, double time) {
+        while (hi > lo + 1) {
+          size_t mid = lo + (hi - lo) / 2;
+          if (times[mid] > time) {
+            hi = mid;
+          }
+          else {
+            lo = mid;
+          }
+        }
+        return lo;
+      }
+
+      size_t m_interval;
+  };
+}
+
+#endif
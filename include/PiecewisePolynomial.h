@@ -0,0 +1,326 @@
+#ifndef ALE_PIECEWISEPOLYNOMIAL_H
+#define ALE_PIECEWISEPOLYNOMIAL_H
+
+#include <vector>
+
+#include "DataView.h"
+#include "IntervalCursor.h"
+#include "Interpolator.h"
+#include "UniformTimeGrid.h"
+
+namespace ale {
+
+  /// How non-throwing evaluation handles times outside of the breakpoints
+  enum extrapolation {
+    /// Times outside of the breakpoints are not evaluated
+    noExtrapolation,
+    /// Use the value at the nearest end, with a zero derivative
+    clampToEnds,
+    /// Extend the polynomial of the nearest end interval
+    extrapolateEnds
+  };
+
+  /// The result of a non-throwing evaluation, ordered from best to worst
+  enum evaluationStatus {
+    /// The time was within the breakpoints
+    evaluated,
+    /// The time was outside of the breakpoints and was clamped to the nearest end
+    clamped,
+    /// The time was outside of the breakpoints and the end polynomial was extended
+    extrapolated,
+    /// The time was outside of the breakpoints, or NaN, and nothing was written
+    outOfRange
+  };
+
+  /**
+   * A set of piecewise polynomials that share the same breakpoints.
+   *
+   * Each interval between two consecutive times stores the polynomial
+   * coefficients of every channel next to each other. Evaluating all of the
+   * channels at a time does a single interval search, and the value and first
+   * derivative of each channel are computed together.
+   *
+   * The breakpoints are either an array of times or a UniformTimeGrid. With a
+   * grid no times are stored and the interval is computed directly.
+   *
+   * All of the input is validated when the polynomials are constructed, so
+   * tryEvaluate only has to check the time and never throws.
+   */
+  class PiecewisePolynomial {
+    public:
+      /**
+       * Construct linear interpolations between a set of values.
+       *
+       * @param times The time of each sample. Must be strictly increasing.
+       * @param values The value of each channel at each time.
+       *
+       * @return The interpolating polynomials.
+       */
+      static PiecewisePolynomial linear(const DataView& times, const MatrixView& values);
+      static PiecewisePolynomial linear(const UniformTimeGrid& times, const MatrixView& values);
+
+      /**
+       * Construct natural cubic splines through a set of values.
+       *
+       * @param times The time of each sample. Must be strictly increasing and
+       *              have at least three times.
+       * @param values The value of each channel at each time.
+       *
+       * @return The interpolating polynomials.
+       */
+      static PiecewisePolynomial spline(const DataView& times, const MatrixView& values);
+      static PiecewisePolynomial spline(const UniformTimeGrid& times, const MatrixView& values);
+
+      /**
+       * Construct cubic Hermite polynomials from values and first derivatives.
+       *
+       * Each interval is the unique cubic that matches the values and
+       * derivatives at both of its ends.
+       *
+       * @param times The time of each sample. Must be strictly increasing.
+       * @param values The value of each channel at each time.
+       * @param derivatives The first derivative of each channel at each time.
+       *
+       * @return The interpolating polynomials.
+       */
+      static PiecewisePolynomial hermite(const DataView& times,
+                                         const MatrixView& values,
+                                         const MatrixView& derivatives);
+      static PiecewisePolynomial hermite(const UniformTimeGrid& times,
+                                         const MatrixView& values,
+                                         const MatrixView& derivatives);
+
+      /**
+       * Construct Lagrange polynomials through a window of values around each
+       * interval. See lagrangeWindow for how the window is chosen and
+       * lagrangeWeights for how the polynomials are evaluated.
+       *
+       * @param times The time of each sample. Must be strictly increasing.
+       * @param values The value of each channel at each time.
+       *
+       * @return The interpolating polynomials.
+       */
+      static PiecewisePolynomial lagrange(const DataView& times, const MatrixView& values);
+      static PiecewisePolynomial lagrange(const UniformTimeGrid& times, const MatrixView& values);
+
+      /**
+       * Construct interpolating polynomials for an interpolation type.
+       *
+       * @param times The time of each sample. Must be strictly increasing.
+       * @param values The value of each channel at each time.
+       * @param interp The interpolation type. Hermite interpolation needs
+       *               derivatives and is not supported, use hermite instead.
+       *
+       * @return The interpolating polynomials.
+       */
+      static PiecewisePolynomial fromInterpolation(const DataView& times, const MatrixView& values,
+                                                   interpolation interp);
+      static PiecewisePolynomial fromInterpolation(const UniformTimeGrid& times, const MatrixView& values,
+                                                   interpolation interp);
+
+      /**
+       * Get the samples that Lagrange interpolation uses for an interval.
+       *
+       * This matches the usgscsm lagrangeInterp window, which uses 8 samples
+       * centered on the interval and drops to 6, 4, or 2 samples next to the
+       * ends of the data so the window stays centered.
+       *
+       * @param interval The interval being interpolated.
+       * @param numSamples The total number of samples.
+       * @param first Output for the index of the first sample in the window.
+       * @param count Output for the number of samples in the window.
+       */
+      static void lagrangeWindow(size_t interval, size_t numSamples, size_t &first, size_t &count);
+
+      /**
+       * Get the weight of each sample in the Lagrange window around a time.
+       *
+       * The interpolated value is the sum of weights[i] times sample
+       * first + i, accumulated in order starting from zero. Every Lagrange
+       * interpolation in ale, including Interpolator, is evaluated this way.
+       *
+       * On a uniform grid the weights are computed with the same arithmetic
+       * as the usgscsm lagrangeInterp, so values interpolated over a grid
+       * built from an ISD's t0 and dt keywords are identical to the sensor
+       * model's. Explicit times use the general Lagrange basis through the
+       * same window, which matches lagrangeInterp to rounding.
+       *
+       * @param times The sample times.
+       * @param interval The interval that contains the time, clamped to the
+       *                 first and last intervals. Uniform grids compute it
+       *                 from the time, like lagrangeInterp.
+       * @param time The time to interpolate at.
+       * @param first Output for the index of the first sample in the window.
+       * @param weights Output array for the weight of each sample, up to 8.
+       * @param derivativeWeights Output array for the weights of the first
+       *                          derivative. Can be null if it is not needed.
+       * @param secondDerivativeWeights Output array for the weights of the
+       *                                second derivative. Can be null if it
+       *                                is not needed.
+       *
+       * @return The number of samples in the window.
+       */
+      static size_t lagrangeWeights(const UniformTimeGrid& times, double time, size_t &first,
+                                    double *weights, double *derivativeWeights = nullptr,
+                                    double *secondDerivativeWeights = nullptr);
+      static size_t lagrangeWeights(const DataView& times, size_t interval, double time, size_t &first,
+                                    double *weights, double *derivativeWeights = nullptr,
+                                    double *secondDerivativeWeights = nullptr);
+
+      /**
+       * Evaluate every channel at a time.
+       *
+       * @param time The time to evaluate at. Must be within the input times.
+       * @param values Output array for the value of each channel.
+       * @param derivatives Output array for the first derivative of each
+       *                    channel. Can be null if they are not needed.
+       */
+      void evaluate(double time, double *values, double *derivatives = nullptr);
+
+      /**
+       * Evaluate every channel at a set of times.
+       *
+       * The interval search is carried over from each time to the next, so
+       * sorted times are the cheapest to evaluate.
+       *
+       * @param times The times to evaluate at. Must be within the input times.
+       * @param numTimes The number of times to evaluate at.
+       * @param values Output array for the values, numChannels values for each
+       *               time. Can be null if only the derivatives are needed.
+       * @param derivatives Output array for the first derivatives, numChannels
+       *                    values for each time. Can be null if they are not needed.
+       */
+      void evaluate(const double *times, size_t numTimes, double *values, double *derivatives = nullptr);
+
+      /**
+       * Evaluate every channel at a sorted set of times.
+       *
+       * The interval search only moves forward from each time to the next, so
+       * walking the whole set of polynomials costs amortized O(1) per time.
+       *
+       * @param times The times to evaluate at. Must be sorted in ascending
+       *              order and within the input times.
+       * @param numTimes The number of times to evaluate at.
+       * @param values Output array for the values, numChannels values for each
+       *               time. Can be null if only the derivatives are needed.
+       * @param derivatives Output array for the first derivatives, numChannels
+       *                    values for each time. Can be null if they are not needed.
+       */
+      void sweep(const double *times, size_t numTimes, double *values, double *derivatives = nullptr);
+
+      /**
+       * Evaluate every channel at a time without throwing.
+       *
+       * Times outside of the breakpoints are handled according to the
+       * extrapolation mode.
+       *
+       * @param time The time to evaluate at.
+       * @param values Output array for the value of each channel. Can be
+       *               null if only the derivatives are needed.
+       * @param derivatives Output array for the first derivative of each
+       *                    channel. Can be null if they are not needed.
+       *
+       * @return How the time was evaluated. If it is outOfRange, nothing is written.
+       */
+      evaluationStatus tryEvaluate(double time, double *values, double *derivatives = nullptr) noexcept;
+
+      /**
+       * Evaluate every channel at a set of times without throwing.
+       *
+       * Times that are outOfRange are skipped and the rest are still evaluated.
+       *
+       * @param times The times to evaluate at.
+       * @param numTimes The number of times to evaluate at.
+       * @param values Output array for the values, numChannels values for each
+       *               time. Can be null if only the derivatives are needed.
+       * @param derivatives Output array for the first derivatives, numChannels
+       *                    values for each time. Can be null if they are not needed.
+       *
+       * @return The worst status of all of the times.
+       */
+      evaluationStatus tryEvaluate(const double *times, size_t numTimes,
+                                   double *values, double *derivatives = nullptr) noexcept;
+
+      /**
+       * Set how tryEvaluate handles times outside of the breakpoints. The
+       * default is noExtrapolation.
+       */
+      void setExtrapolation(extrapolation mode) {
+        m_extrapolation = mode;
+      }
+
+      extrapolation extrapolationMode() const {
+        return m_extrapolation;
+      }
+
+      /**
+       * The number of channels.
+       */
+      size_t numChannels() const {
+        return m_numChannels;
+      }
+
+      /**
+       * The number of breakpoints.
+       */
+      size_t size() const {
+        return m_uniform ? m_grid.size() : m_times.size();
+      }
+
+      /**
+       * The number of coefficients in each polynomial, one more than the degree.
+       */
+      size_t order() const {
+        return m_order;
+      }
+
+      /**
+       * If the breakpoints are a uniform time grid.
+       */
+      bool isUniform() const {
+        return m_uniform;
+      }
+
+    private:
+      PiecewisePolynomial(const DataView& times, size_t numChannels, size_t order);
+      PiecewisePolynomial(const UniformTimeGrid& times, size_t numChannels, size_t order);
+
+      // Get a breakpoint
+      double time(size_t index) const {
+        return m_uniform ? m_grid[index] : m_times[index];
+      }
+
+      // Find the interval that contains a time
+      size_t findInterval(double time);
+
+      // Find the interval that contains a time within the breakpoints
+      size_t locateInterval(double time) {
+        return m_uniform ? m_grid.interval(time) : m_cursor.find(m_times.data(), m_times.size(), time);
+      }
+
+      // Evaluate every channel in an interval
+      void evaluateInterval(size_t interval, double time, double *values, double *derivatives) const;
+
+      // Evaluate every channel of a Lagrange interpolation from its samples
+      void evaluateLagrange(size_t interval, double time, double *values, double *derivatives) const;
+
+      // The breakpoints, empty if they are a uniform grid
+      std::vector<double> m_times;
+      // The breakpoints if they are a uniform grid
+      UniformTimeGrid m_grid;
+      bool m_uniform;
+      size_t m_numChannels;
+      size_t m_order;
+      // If the samples are stored instead of coefficients
+      bool m_lagrange;
+      extrapolation m_extrapolation;
+      // The coefficients of each channel in each interval, lowest order
+      // first. For Lagrange interpolation, the value of each channel at each
+      // sample instead.
+      std::vector<double> m_coeffs;
+      // The search position from the last evaluation
+      IntervalCursor m_cursor;
+  };
+}
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef ALE_POLYNOMIAL_H
+#define ALE_POLYNOMIAL_H
+
+#include <cstddef>
+
+namespace ale {
+
+  /// The largest degree with an unrolled kernel in the runtime dispatch
+  const int maxUnrolledDegree = 10;
+
+  namespace detail {
+    // k! / (k - d)!, the factor the k-th coefficient picks up from d derivatives
+    constexpr double fallingFactorial(int k, int d) {
+      return d <= 0 ? 1.0 : k * fallingFactorial(k - 1, d - 1);
+    }
+
+    // One step of Horner's method for the d-th derivative, from coefficient
+    // K up to the degree N
+    template <int N, int D, int K>
+    struct Horner {
+      static constexpr double eval(const double *coeffs, double time) {
+        return coeffs[K] * fallingFactorial(K, D) + time * Horner<N, D, K + 1>::eval(coeffs, time);
+      }
+    };
+
+    template <int N, int D>
+    struct Horner<N, D, N> {
+      static constexpr double eval(const double *coeffs, double) {
+        return coeffs[N] * fallingFactorial(N, D);
+      }
+    };
+  }
+
+  /**
+   * Evaluate a polynomial, or one of its derivatives, whose degree is known
+   * at compile time.
+   *
+   * Horner's method is fully unrolled, so there is no loop or allocation, and
+   * the polynomial can be evaluated at compile time if its coefficients are
+   * constant expressions.
+   *
+   * @tparam N The degree of the polynomial.
+   * @tparam D The order of the derivative to evaluate.
+   *
+   * @param coeffs The N + 1 coefficients of the polynomial, lowest order first.
+   * @param time The time to evaluate at.
+   *
+   * @return The value of the derivative at the time.
+   */
+  template <int N, int D>
+  constexpr double evaluatePolynomial(const double *coeffs, double time) {
+    return D > N ? 0.0 : detail::Horner<N, D, (D > N ? N : D)>::eval(coeffs, time);
+  }
+
+  /**
+   * Evaluate a polynomial, or one of its derivatives, at a single time.
+   *
+   * Polynomials up to maxUnrolledDegree with derivatives up to the second are
+   * dispatched to the unrolled kernels. Anything else uses a Horner loop.
+   *
+   * @param coeffs The coefficients of the polynomial, lowest order first.
+   * @param numCoeffs The number of coefficients. Must be at least one.
+   * @param time The time to evaluate at.
+   * @param d The order of the derivative to evaluate. Must be non-negative.
+   *
+   * @return The value of the derivative at the time.
+   */
+  double evaluatePolynomial(const double *coeffs, size_t numCoeffs, double time, int d);
+
+  /**
+   * Evaluate a polynomial and its first two derivatives at a set of times.
+   *
+   * The polynomial is evaluated with Horner's method. When the library is
+   * compiled with AVX2 and FMA or AVX-512 support, several times are
+   * evaluated at once in vector registers. Otherwise a scalar loop is used.
+   *
+   * @param coeffs The coefficients of the polynomial, lowest order first.
+   * @param numCoeffs The number of coefficients. Must be at least one.
+   * @param times The times to evaluate at.
+   * @param numTimes The number of times to evaluate at.
+   * @param values Output array for the value at each time. Can be null if
+   *               the values are not needed.
+   * @param firstDerivatives Output array for the first derivative at each
+   *                         time. Can be null if they are not needed.
+   * @param secondDerivatives Output array for the second derivative at each
+   *                          time. Can be null if they are not needed.
+   */
+  void evaluatePolynomial(const double *coeffs, size_t numCoeffs,
+                          const double *times, size_t numTimes,
+                          double *values,
+                          double *firstDerivatives = nullptr,
+                          double *secondDerivatives = nullptr);
+}
+
+#endif
@@ -1,18 +1,25 @@
 #ifndef ALE_ROTATION_H
 #define ALE_ROTATION_H
 
-#include <memory>
+#include <array>
+#include <cstddef>
+#include <utility>
 #include <vector>
 
 namespace ale {
 
   enum RotationInterpolation {
     slerp, // Spherical interpolation
-    nlerp // Normalized linear interpolation
+    nlerp, // Normalized linear interpolation
+    squad, // Spherical cubic interpolation, only for a series of rotations
+    fastSlerp // Polynomial approximation of slerp without trigonometry
   };
 
   /**
    * A generic 3D rotation.
+   *
+   * The quaternion is stored inline, so rotations are trivially copyable and
+   * constructing, copying, and chaining them never allocates.
    */
   class Rotation {
     public:
@@ -50,14 +57,6 @@ namespace ale {
        * @param theta The rotation about the axis in radians.
        */
       Rotation(const std::vector<double>& axis, double theta);
-      ~Rotation();
-
-      // Special member functions
-      Rotation(Rotation && other) noexcept;
-      Rotation& operator=(Rotation && other) noexcept;
-
-      Rotation(const Rotation& other);
-      Rotation& operator=(const Rotation& other);
 
       // Type specific accessors
       /**
@@ -66,12 +65,25 @@ namespace ale {
        * @return The rotation as a scalar-first quaternion (w, x, y, z).
        */
       std::vector<double> toQuaternion() const;
+      /**
+       * The rotation as a quaternion, without allocating.
+       *
+       * @param quaternion Output array for the scalar-first quaternion (w, x, y, z).
+       */
+      void toQuaternion(double *quaternion) const noexcept;
       /**
        * The rotation as a rotation matrix.
        *
        * @return The rotation as a rotation matrix in row-major order.
        */
       std::vector<double> toRotationMatrix() const;
+      /**
+       * The rotation as a rotation matrix, without allocating.
+       *
+       * @param matrix Output array for the 9 elements of the matrix, in the
+       *               same order as toRotationMatrix().
+       */
+      void toRotationMatrix(double *matrix) const noexcept;
       /**
        * Create a state rotation matrix from the rotation and an angula velocity.
        *
@@ -80,6 +92,15 @@ namespace ale {
        * @return The state rotation matrix in row-major order.
        */
       std::vector<double> toStateRotationMatrix(const std::vector<double> &av) const;
+      /**
+       * Create a state rotation matrix from the rotation and an angular
+       * velocity, without allocating.
+       *
+       * @param av The 3 element angular velocity vector.
+       * @param matrix Output array for the 36 elements of the state rotation
+       *               matrix in row-major order.
+       */
+      void toStateRotationMatrix(const double *av, double *matrix) const noexcept;
       /**
        * The rotation as Euler angles.
        *
@@ -88,12 +109,27 @@ namespace ale {
        * @return The rotations about the axes in radians.
        */
       std::vector<double> toEuler(const std::vector<int>& axes) const;
+      /**
+       * The rotation as Euler angles, without allocating.
+       *
+       * @param axes The axis order. 0 is X, 1 is Y, and 2 is Z.
+       * @param angles Output array for the 3 rotations about the axes in radians.
+       */
+      void toEuler(const std::array<int, 3>& axes, double *angles) const;
       /**
        * The rotation as a rotation about an axis.
        *
        * @return the axis of rotation and rotation in radians.
        */
       std::pair<std::vector<double>, double> toAxisAngle() const;
+      /**
+       * The rotation as a rotation about an axis, without allocating.
+       *
+       * @param axis Output array for the 3 element axis of rotation.
+       *
+       * @return The rotation about the axis in radians.
+       */
+      double toAxisAngle(double *axis) const noexcept;
 
       // Generic rotation operations
       /**
@@ -105,6 +141,54 @@ namespace ale {
        * @return The rotated vector.
        */
       std::vector<double> operator()(const std::vector<double>& vector, const std::vector<double>& av = {0.0, 0.0, 0.0}) const;
+      /**
+       * Rotate a position vector.
+       *
+       * Unlike operator(), the size of the vector is not checked and nothing
+       * is allocated, so this never throws.
+       *
+       * @param vector The 3 element vector to rotate.
+       * @param rotated Output array for the 3 element rotated vector. Can be
+       *                the same array as vector.
+       */
+      void apply(const double *vector, double *rotated) const noexcept;
+      /**
+       * Rotate a set of position vectors.
+       *
+       * The rotation matrix is built once for all of the vectors.
+       *
+       * @param vectors The x, y, and z of each vector, 3 * numVectors doubles.
+       * @param rotated Output array for the rotated vectors, 3 * numVectors
+       *                doubles. Can be the same array as vectors.
+       * @param numVectors The number of vectors.
+       */
+      void apply(const double *vectors, double *rotated, size_t numVectors) const noexcept;
+      /**
+       * Rotate a set of state vectors with the same angular velocity.
+       *
+       * This is the same as operator() with a 6 element state for each
+       * state, but the rotation matrix and its derivative are built once.
+       *
+       * @param states The position and velocity of each state, 6 * numStates doubles.
+       * @param rotated Output array for the rotated states, 6 * numStates
+       *                doubles. Can be the same array as states.
+       * @param numStates The number of states.
+       * @param av The angular velocity. If null, it is 0.
+       */
+      void applyState(const double *states, double *rotated, size_t numStates,
+                      const double *av = nullptr) const noexcept;
+      /**
+       * Rotate a set of state vectors that each have their own angular velocity.
+       *
+       * @param states The position and velocity of each state, 6 * numStates doubles.
+       * @param angularVelocities The angular velocity for each state,
+       *                          3 * numStates doubles.
+       * @param rotated Output array for the rotated states, 6 * numStates
+       *                doubles. Can be the same array as states.
+       * @param numStates The number of states.
+       */
+      void applyStateSeries(const double *states, const double *angularVelocities,
+                            double *rotated, size_t numStates) const noexcept;
       /**
        * Get the inverse rotation.
        */
@@ -124,13 +208,284 @@ namespace ale {
        * @param The interpolated rotation.
        */
       Rotation interpolate(const Rotation& nextRotation, double t, RotationInterpolation interpType) const;
+      /**
+       * Interpolate between this rotation and another rotation at a set of
+       * distances.
+       *
+       * Work that does not depend on the distance is done once, so with
+       * fastSlerp each distance is a handful of multiplies and a square root.
+       *
+       * fastSlerp replaces the sines in slerp with the first terms of their
+       * series in the cosine of the angle between the quaternions. For
+       * distances between 0 and 1, the angular error is below 1e-12 radians
+       * for rotations within 0.5 radians of each other and below 1e-8
+       * radians within 1 radian. It grows for rotations farther apart, up to
+       * about 3e-3 radians for opposite rotations.
+       *
+       * @param nextRotation The rotation to interpolate towards.
+       * @param t The distances to interpolate. 0 is this and 1 is the next rotation.
+       * @param numTimes The number of distances.
+       * @param quaternions Output array for the w, x, y, and z of each
+       *                    interpolated unit quaternion, 4 * numTimes doubles.
+       * @param interpType The type of rotation interpolation to use.
+       */
+      void interpolate(const Rotation& nextRotation, const double *t, size_t numTimes,
+                       double *quaternions, RotationInterpolation interpType) const;
+
+    private:
+      friend class PreparedRotation;
+
+      // The quaternion stored x, y, z, w, which is Eigen's order. It is held
+      // in the object so rotations never allocate and can be copied into arrays.
+      double m_coeffs[4];
+  };
+
+  /**
+   * A rotation with its rotation matrix, and the derivative of the matrix
+   * for an angular velocity, built ahead of time.
+   *
+   * Rotation builds its matrix from the quaternion each time it rotates a
+   * state. When the same rotation is applied over and over, build one of
+   * these once and every application is a plain matrix multiply. The
+   * results are the same as the batch applications on Rotation.
+   */
+  class PreparedRotation {
+    public:
+      /**
+       * Prepare a rotation.
+       *
+       * @param rotation The rotation.
+       * @param av The 3 element angular velocity to use when rotating state
+       *           vectors. If null, it is 0.
+       */
+      explicit PreparedRotation(const Rotation& rotation, const double *av = nullptr);
+
+      /**
+       * The rotation that was prepared.
+       */
+      const Rotation& rotation() const {
+        return m_rotation;
+      }
+
+      /**
+       * The rotation matrix, 9 doubles in the same order as
+       * Rotation::toRotationMatrix.
+       */
+      const double *rotationMatrix() const {
+        return m_matrix;
+      }
+
+      /**
+       * The state rotation matrix, the same as Rotation::toStateRotationMatrix.
+       *
+       * @param matrix Output array for the 36 elements of the state rotation
+       *               matrix in row-major order.
+       */
+      void toStateRotationMatrix(double *matrix) const noexcept;
+
+      /**
+       * Rotate a vector.
+       *
+       * @param vector The vector to rotate. Can be a 3 element position or 6
+       *               element state.
+       *
+       * @return The rotated vector.
+       */
+      std::vector<double> operator()(const std::vector<double>& vector) const;
+      /**
+       * Rotate a set of position vectors.
+       *
+       * @param vectors The x, y, and z of each vector, 3 * numVectors doubles.
+       * @param rotated Output array for the rotated vectors, 3 * numVectors
+       *                doubles. Can be the same array as vectors.
+       * @param numVectors The number of vectors.
+       */
+      void apply(const double *vectors, double *rotated, size_t numVectors = 1) const noexcept;
+      /**
+       * Rotate a set of state vectors with the prepared angular velocity.
+       *
+       * @param states The position and velocity of each state, 6 * numStates doubles.
+       * @param rotated Output array for the rotated states, 6 * numStates
+       *                doubles. Can be the same array as states.
+       * @param numStates The number of states.
+       */
+      void applyState(const double *states, double *rotated, size_t numStates = 1) const noexcept;
 
     private:
-      // Implementation class
-      class Impl;
-      // Pointer to internal rotation implementation.
-      std::unique_ptr<Impl> m_impl;
+      Rotation m_rotation;
+      // Both matrices are stored column-major, like Eigen
+      double m_matrix[9];
+      // The rotation matrix times the skew matrix of the angular velocity
+      double m_derivative[9];
   };
+
+  /**
+   * A rotation that changes over time, sampled at a set of times.
+   *
+   * This is the native version of ale.rotation.TimeDependentRotation. The
+   * quaternions, times, and optional angular velocities are each stored
+   * contiguously so that they can be shared with numpy without copying. The
+   * source and destination frames are left to the caller.
+   *
+   * Between the times the rotation turns at a constant angular velocity, as
+   * in TimeDependentRotation._slerp. Angular velocities are expressed in the
+   * destination frame. If angular velocities are stored, they are linearly
+   * interpolated and the end angular velocities are used to extrapolate.
+   * Otherwise, the angular velocity of each interval is used and the end
+   * intervals are extended. Times outside of the rotation are always
+   * extrapolated.
+   */
+  class TimeDependentRotation {
+    public:
+      /**
+       * Construct a time dependent rotation.
+       *
+       * @param quaternions The w, x, y, and z components of each quaternion,
+       *                    4 doubles for each time. They are normalized.
+       * @param times The time of each quaternion. Must be strictly increasing.
+       * @param angularVelocities The x, y, and z angular velocity at each
+       *                          time, 3 doubles for each time. If empty, the
+       *                          angular velocities are computed from the
+       *                          quaternions.
+       */
+      TimeDependentRotation(const std::vector<double>& quaternions,
+                            const std::vector<double>& times,
+                            const std::vector<double>& angularVelocities = {});
+
+      /**
+       * Get the rotations and angular velocities at a set of times.
+       *
+       * @param times The times to interpolate at.
+       * @param numTimes The number of times.
+       * @param quaternions Output array for the rotations, 4 * numTimes doubles
+       *                    ordered w, x, y, z for each time. Can be null.
+       * @param angularVelocities Output array for the angular velocities,
+       *                          3 * numTimes doubles ordered x, y, z for each
+       *                          time. Can be null.
+       */
+      void interpolate(const double *times, size_t numTimes,
+                       double *quaternions, double *angularVelocities) const;
+
+      /**
+       * Sample the rotation at a new set of times.
+       *
+       * @param times The new times. Must be strictly increasing.
+       *
+       * @return The rotation at the new times, with angular velocities.
+       */
+      TimeDependentRotation reinterpolate(const std::vector<double>& times) const;
+
+      /**
+       * Get the inverse rotation.
+       */
+      TimeDependentRotation inverse() const;
+
+      /**
+       * Chain this rotation with another time dependent rotation.
+       *
+       * The result is sampled at the union of the times of both rotations, so
+       * it covers every time in either rotation. The times are merged and both
+       * rotations are evaluated and chained in a single pass. Rotations are
+       * sequenced right to left.
+       */
+      TimeDependentRotation operator*(const TimeDependentRotation& rightRotation) const;
+
+      /**
+       * Chain this rotation with another time dependent rotation at a chosen
+       * set of times.
+       *
+       * Neither rotation is reinterpolated first, so composing a chain of
+       * rotations onto the same times never builds the merged times of each
+       * step.
+       *
+       * @param rightRotation The rotation to apply first.
+       * @param times The times of the result. Must be strictly increasing.
+       *
+       * @return The chained rotation at the times, with angular velocities.
+       */
+      TimeDependentRotation compose(const TimeDependentRotation& rightRotation,
+                                    const std::vector<double>& times) const;
+
+      /**
+       * Chain this rotation with a constant rotation.
+       *
+       * Rotations are sequenced right to left.
+       */
+      TimeDependentRotation operator*(const Rotation& rightRotation) const;
+
+      /**
+       * Rotate a set of position vectors, each at its own time.
+       *
+       * @param positions The x, y, and z of each position, 3 * numTimes doubles.
+       * @param times The time to rotate each position at.
+       * @param numTimes The number of positions and times.
+       * @param rotated Output array for the rotated positions, 3 * numTimes
+       *                doubles. Can be the same array as positions.
+       */
+      void apply(const double *positions, const double *times, size_t numTimes,
+                 double *rotated) const;
+
+      /**
+       * Rotate a set of state vectors, each at its own time.
+       *
+       * Velocities include the change in the rotation, like Rotation::operator()
+       * with an angular velocity.
+       *
+       * @param positions The x, y, and z of each position, 3 * numTimes doubles.
+       * @param velocities The x, y, and z of each velocity, 3 * numTimes doubles.
+       * @param times The time to rotate each state at.
+       * @param numTimes The number of states and times.
+       * @param rotatedPositions Output array for the rotated positions,
+       *                         3 * numTimes doubles. Can be null.
+       * @param rotatedVelocities Output array for the rotated velocities,
+       *                          3 * numTimes doubles.
+       */
+      void applyState(const double *positions, const double *velocities,
+                      const double *times, size_t numTimes,
+                      double *rotatedPositions, double *rotatedVelocities) const;
+
+      /**
+       * The w, x, y, and z components of each quaternion.
+       */
+      const std::vector<double>& quaternions() const {
+        return m_quaternions;
+      }
+
+      const std::vector<double>& times() const {
+        return m_times;
+      }
+
+      /**
+       * The x, y, and z angular velocity at each time. Empty if there are no
+       * angular velocities.
+       */
+      const std::vector<double>& angularVelocities() const {
+        return m_angularVelocities;
+      }
+
+      bool hasAngularVelocities() const {
+        return !m_angularVelocities.empty();
+      }
+
+      /**
+       * The number of times.
+       */
+      size_t size() const {
+        return m_times.size();
+      }
+
+    private:
+      std::vector<double> m_quaternions;
+      std::vector<double> m_times;
+      std::vector<double> m_angularVelocities;
+  };
+
+  /**
+   * Chain a constant rotation with a time dependent rotation.
+   *
+   * Rotations are sequenced right to left.
+   */
+  TimeDependentRotation operator*(const Rotation& leftRotation, const TimeDependentRotation& rightRotation);
 }
 
 #endif
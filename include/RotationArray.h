@@ -0,0 +1,133 @@
+#ifndef ALE_ROTATIONARRAY_H
+#define ALE_ROTATIONARRAY_H
+
+#include <cstddef>
+#include <vector>
+
+#include "DataView.h"
+#include "Rotation.h"
+
+namespace ale {
+
+  /**
+   * An array of rotations stored as a structure of arrays.
+   *
+   * All of the w components are stored together, then all of the x, y, and z
+   * components, so element-wise operations run down contiguous arrays. Each
+   * operation matches the same operation on a single Rotation.
+   *
+   * The element-wise operations have AVX2 paths that process four rotations
+   * at a time. They are only compiled when the build targets AVX2, see the
+   * ALE_NATIVE_ARCH option, and otherwise the same formulas run as scalar
+   * loops. toEuler builds the matrices with the vector path but takes the
+   * angles one rotation at a time.
+   */
+  class RotationArray {
+    public:
+      /**
+       * Construct an array of identity rotations.
+       *
+       * @param size The number of rotations.
+       */
+      explicit RotationArray(size_t size = 0);
+
+      /**
+       * Construct an array from a set of quaternions. They are normalized.
+       *
+       * @param quaternions A view of the w, x, y, and z quaternion components.
+       */
+      explicit RotationArray(const MatrixView& quaternions);
+
+      /**
+       * Construct an array from a set of rotation matrices.
+       *
+       * @param matrices The rotation matrices, 9 doubles for each rotation in
+       *                 the same order as Rotation::toRotationMatrix.
+       * @param size The number of rotations.
+       */
+      static RotationArray fromMatrices(const double *matrices, size_t size);
+
+      /**
+       * Construct an array from a set of Euler angle rotations.
+       *
+       * @param angles A view of the rotations about the axes, one component
+       *               for each axis.
+       * @param axes The axes to rotate about, in order. 0 is X, 1 is Y, and 2 is Z.
+       */
+      static RotationArray fromEuler(const MatrixView& angles, const std::vector<int>& axes);
+
+      /**
+       * The number of rotations.
+       */
+      size_t size() const {
+        return m_size;
+      }
+
+      /**
+       * A view of the w, x, y, and z quaternion components.
+       */
+      MatrixView quaternions() const {
+        return MatrixView(m_coeffs.data(), 4, m_size, m_size, 1);
+      }
+
+      /**
+       * Get a single rotation.
+       */
+      Rotation operator[](size_t index) const {
+        return Rotation(m_coeffs[index], m_coeffs[m_size + index],
+                        m_coeffs[2 * m_size + index], m_coeffs[3 * m_size + index]);
+      }
+
+      /**
+       * Chain each rotation with the rotation at the same index in another
+       * array.
+       *
+       * Rotations are sequenced right to left.
+       *
+       * @param rightRotations The rotations to apply first. Must be the same size.
+       */
+      RotationArray operator*(const RotationArray& rightRotations) const;
+
+      /**
+       * Get the inverse of each rotation.
+       */
+      RotationArray inverse() const;
+
+      /**
+       * Normalize each quaternion.
+       */
+      void normalize();
+
+      /**
+       * Copy the quaternions out.
+       *
+       * @param quaternions Output array for the w, x, y, and z of each
+       *                    rotation, 4 * size doubles.
+       */
+      void toQuaternions(double *quaternions) const;
+
+      /**
+       * Convert each rotation to a rotation matrix.
+       *
+       * @param matrices Output array for the matrices, 9 * size doubles in the
+       *                 same order as Rotation::toRotationMatrix.
+       */
+      void toMatrices(double *matrices) const;
+
+      /**
+       * Convert each rotation to Euler angles.
+       *
+       * @param axes The axis order. 0 is X, 1 is Y, and 2 is Z.
+       * @param angles Output array for the rotations about the axes in
+       *               radians, 3 * size doubles.
+       */
+      void toEuler(const std::vector<int>& axes, double *angles) const;
+
+    private:
+      size_t m_size;
+      // The w components, then the x, y, and z components
+      std::vector<double> m_coeffs;
+  };
+}
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef ALE_ROTATIONINTERPOLATOR_H
+#define ALE_ROTATIONINTERPOLATOR_H
+
+#include <cstddef>
+#include <vector>
+
+#include "DataView.h"
+#include "IntervalCursor.h"
+#include "PiecewisePolynomial.h"
+#include "Rotation.h"
+#include "Tables.h"
+#include "UniformTimeGrid.h"
+
+namespace ale {
+
+  /**
+   * Interpolation over a series of rotations that stays on the unit sphere.
+   *
+   * slerp turns at a constant angular velocity across each interval, which
+   * is the same model as Rotation::interpolate and
+   * ale.rotation.TimeDependentRotation._slerp. nlerp normalizes a linear
+   * interpolation of the quaternions. squad is Shoemake's spherical cubic,
+   * whose angular velocity is continuous across the input rotations.
+   * fastSlerp approximates slerp without trigonometry, see
+   * Rotation::interpolate for its error, and reports slerp's angular velocity.
+   *
+   * Angular velocities follow TimeDependentRotation: they are the rotation
+   * vector from each rotation to the next divided by the time between them,
+   * so they are expressed in the destination frame.
+   *
+   * The input is validated, and the quaternions normalized and sign
+   * aligned, once at construction. Like RotationTable, evaluation never
+   * throws and returns a status instead. With extrapolateEnds, times past
+   * either end turn at the angular velocity of the end interval, as in
+   * TimeDependentRotation._slerp.
+   */
+  class RotationInterpolator {
+    public:
+      /**
+       * Construct an interpolator from a view of a set of quaternions.
+       *
+       * @param quaternions A view of the w, x, y, and z quaternion components.
+       * @param times The time of each quaternion. Must be strictly increasing.
+       * @param interp The interpolation type.
+       * @param mode How times outside of the rotations are handled.
+       */
+      RotationInterpolator(const MatrixView& quaternions, const DataView& times,
+                           RotationInterpolation interp, extrapolation mode = noExtrapolation);
+      RotationInterpolator(const MatrixView& quaternions, const UniformTimeGrid& times,
+                           RotationInterpolation interp, extrapolation mode = noExtrapolation);
+
+      /**
+       * Construct an interpolator from a table of quaternions.
+       *
+       * @param rotations The table of quaternions.
+       * @param interp The interpolation type.
+       * @param mode How times outside of the rotations are handled.
+       */
+      RotationInterpolator(const QuaternionTable& rotations, RotationInterpolation interp,
+                           extrapolation mode = noExtrapolation);
+
+      /**
+       * Get the rotation at a time.
+       *
+       * @param time The time to get the rotation at.
+       * @param quaternion Output array for the w, x, y, and z unit quaternion.
+       *
+       * @return How the time was evaluated. If it is outOfRange, nothing is written.
+       */
+      evaluationStatus rotation(double time, double *quaternion) noexcept;
+
+      /**
+       * Get the rotation and angular velocity at a time.
+       *
+       * @param time The time to evaluate at.
+       * @param quaternion Output array for the w, x, y, and z unit quaternion.
+       *                   Can be null if it is not needed.
+       * @param angularVelocity Output array for the x, y, and z angular
+       *                        velocity. Can be null if it is not needed.
+       *
+       * @return How the time was evaluated. If it is outOfRange, nothing is written.
+       */
+      evaluationStatus state(double time, double *quaternion, double *angularVelocity) noexcept;
+
+      /**
+       * Get the rotations and angular velocities at a set of times.
+       *
+       * @param times The times to evaluate at. Sorted times are the cheapest.
+       * @param numTimes The number of times.
+       * @param quaternions Output array for the rotations, 4 * numTimes doubles
+       *                    ordered w, x, y, z for each time. Can be null.
+       * @param angularVelocities Output array for the angular velocities,
+       *                          3 * numTimes doubles ordered x, y, z for each
+       *                          time. Can be null.
+       *
+       * @return The worst status of all of the times. Times that are
+       *         outOfRange are skipped.
+       */
+      evaluationStatus states(const double *times, size_t numTimes,
+                              double *quaternions, double *angularVelocities) noexcept;
+
+      /**
+       * The number of rotations.
+       */
+      size_t size() const {
+        return m_uniform ? m_grid.size() : m_times.size();
+      }
+
+      RotationInterpolation interpolationType() const {
+        return m_interp;
+      }
+
+    private:
+      // Normalize, align, and precompute the interval data for the quaternions
+      void prepare(const MatrixView& quaternions);
+
+      // Get the time of a rotation
+      double time(size_t index) const {
+        return m_uniform ? m_grid[index] : m_times[index];
+      }
+
+      // Find the interval for a time within the rotations. A time on a
+      // rotation belongs to the interval that ends there, like numpy's
+      // searchsorted.
+      size_t findInterval(double time);
+
+      // Evaluate an interval at a time, which may be past its ends
+      void evaluateInterval(size_t interval, double time, double *quaternion,
+                            double *angularVelocity) const;
+
+      // The times of the rotations, empty if they are a uniform grid
+      std::vector<double> m_times;
+      // The times of the rotations if they are a uniform grid
+      UniformTimeGrid m_grid;
+      bool m_uniform;
+      RotationInterpolation m_interp;
+      extrapolation m_extrapolation;
+      // The normalized, sign aligned quaternions, w, x, y, z for each rotation
+      std::vector<double> m_quaternions;
+      // The constant angular velocity across each interval
+      std::vector<double> m_angularVelocities;
+      // The squad control quaternions, w, x, y, z for each rotation
+      std::vector<double> m_controls;
+      // The search position from the last evaluation
+      IntervalCursor m_cursor;
+  };
+}
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef ALE_ROTATIONTABLE_H
+#define ALE_ROTATIONTABLE_H
+
+#include <cstddef>
+
+#include "DataView.h"
+#include "Interpolator.h"
+#include "PiecewisePolynomial.h"
+#include "Tables.h"
+#include "UniformTimeGrid.h"
+
+namespace ale {
+
+  /// How input angular velocities relate to the rate of change of their quaternions
+  enum angularVelocityConvention {
+    /// dq/dt = 1/2 (0, av) q, in the destination frame. This is what
+    /// TimeDependentRotation, RotationInterpolator, and SPICE's xf2rav use.
+    destinationFrame,
+    /// dq/dt = -1/2 q (0, av), the negated angular velocity in the source
+    /// frame. This is what RotationTable::angularVelocity returns.
+    negatedSourceFrame
+  };
+
+  /**
+   * A prepared interpolation of spacecraft rotations and angular velocities.
+   *
+   * The input quaternions are normalized and sign aligned, so that each one
+   * is in the same hemisphere as the one before it, and the interpolating
+   * polynomials are built once when the table is constructed. Queries then
+   * only search for the interval, which is O(1) on a uniform time grid and
+   * O(log N) otherwise, and evaluate it.
+   *
+   * Like StateInterpolator, evaluation never throws and returns a status
+   * instead.
+   */
+  class RotationTable {
+    public:
+      /**
+       * Construct a table from a view of a set of quaternions.
+       *
+       * @param quaternions A view of the w, x, y, and z quaternion components.
+       * @param times The time of each quaternion. Must be strictly increasing.
+       * @param interp The interpolation type. Hermite interpolation needs the
+       *               angular velocities, see the constructor below.
+       * @param mode How times outside of the table are handled.
+       */
+      RotationTable(const MatrixView& quaternions, const DataView& times,
+                    interpolation interp, extrapolation mode = noExtrapolation);
+      RotationTable(const MatrixView& quaternions, const UniformTimeGrid& times,
+                    interpolation interp, extrapolation mode = noExtrapolation);
+
+      /**
+       * Construct a table that uses cubic Hermite interpolation over a set of
+       * quaternions and their angular velocities.
+       *
+       * Each interval matches the rotations and angular velocities at both
+       * of its ends, so far fewer samples are needed for the same accuracy
+       * than with interpolation over the quaternions alone.
+       *
+       * @param quaternions A view of the w, x, y, and z quaternion components.
+       * @param angularVelocities A view of the x, y, and z angular velocities.
+       * @param times The time of each quaternion. Must be strictly increasing.
+       * @param mode How times outside of the table are handled.
+       * @param convention The convention of the angular velocities. The
+       *                   default matches TimeDependentRotation, so its
+       *                   angular velocities can be passed in directly.
+       */
+      RotationTable(const MatrixView& quaternions, const MatrixView& angularVelocities,
+                    const DataView& times, extrapolation mode = noExtrapolation,
+                    angularVelocityConvention convention = destinationFrame);
+      RotationTable(const MatrixView& quaternions, const MatrixView& angularVelocities,
+                    const UniformTimeGrid& times, extrapolation mode = noExtrapolation,
+                    angularVelocityConvention convention = destinationFrame);
+
+      /**
+       * Construct a table from a table of quaternions.
+       *
+       * @param rotations The table of quaternions.
+       * @param interp The interpolation type. Hermite interpolation uses the
+       *               angular velocities, so the table must store them.
+       * @param mode How times outside of the table are handled.
+       * @param convention The convention of the table's angular velocities.
+       */
+      RotationTable(const QuaternionTable& rotations, interpolation interp,
+                    extrapolation mode = noExtrapolation,
+                    angularVelocityConvention convention = destinationFrame);
+
+      /**
+       * Get the rotation at a time.
+       *
+       * @param time The time to get the rotation at.
+       * @param quaternion Output array for the w, x, y, and z unit quaternion.
+       *
+       * @return How the time was evaluated. If it is outOfRange, nothing is written.
+       */
+      evaluationStatus rotation(double time, double *quaternion) noexcept;
+
+      /**
+       * Get the angular velocity at a time.
+       *
+       * The angular velocity is in the negatedSourceFrame convention, like
+       * getAngularVelocity.
+       *
+       * @param time The time to get the angular velocity at.
+       * @param angularVelocity Output array for the x, y, and z angular velocity.
+       *
+       * @return How the time was evaluated. If it is outOfRange, nothing is written.
+       */
+      evaluationStatus angularVelocity(double time, double *angularVelocity) noexcept;
+
+      /**
+       * Get the rotation and angular velocity at a time.
+       *
+       * @param time The time to evaluate at.
+       * @param quaternion Output array for the w, x, y, and z unit quaternion.
+       *                   Can be null if it is not needed.
+       * @param angularVelocity Output array for the x, y, and z angular
+       *                        velocity. Can be null if it is not needed.
+       *
+       * @return How the time was evaluated. If it is outOfRange, nothing is written.
+       */
+      evaluationStatus state(double time, double *quaternion, double *angularVelocity) noexcept;
+
+      /**
+       * Get the rotations and angular velocities at a set of times.
+       *
+       * @param times The times to evaluate at.
+       * @param numTimes The number of times.
+       * @param quaternions Output array for the rotations, 4 * numTimes doubles
+       *                    ordered w, x, y, z for each time. Can be null.
+       * @param angularVelocities Output array for the angular velocities,
+       *                          3 * numTimes doubles ordered x, y, z for each
+       *                          time. Can be null.
+       *
+       * @return The worst status of all of the times. Times that are
+       *         outOfRange are skipped.
+       */
+      evaluationStatus states(const double *times, size_t numTimes,
+                              double *quaternions, double *angularVelocities) noexcept;
+
+      /**
+       * The number of rotations in the table.
+       */
+      size_t size() const {
+        return m_quaternions.size();
+      }
+
+    private:
+      // Polynomials over the normalized, sign aligned quaternion components
+      PiecewisePolynomial m_quaternions;
+  };
+}
+
+#endif
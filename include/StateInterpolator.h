@@ -0,0 +1,104 @@
+#ifndef ALE_STATEINTERPOLATOR_H
+#define ALE_STATEINTERPOLATOR_H
+
+#include <cstddef>
+
+#include "DataView.h"
+#include "Interpolator.h"
+#include "PiecewisePolynomial.h"
+#include "Tables.h"
+#include "UniformTimeGrid.h"
+
+namespace ale {
+
+  /**
+   * A prepared interpolation of spacecraft positions and velocities.
+   *
+   * The table is validated and the interpolating polynomials are built once
+   * when the interpolator is constructed. Evaluation never throws, it
+   * returns a status instead, so probing times just outside of the table is
+   * as cheap as any other time.
+   */
+  class StateInterpolator {
+    public:
+      /**
+       * Construct an interpolator over a table of states.
+       *
+       * @param states The table of states.
+       * @param interp The interpolation type. Hermite interpolation requires
+       *               the table to store velocities.
+       * @param mode How times outside of the table are handled.
+       */
+      StateInterpolator(const StateTable& states, interpolation interp,
+                        extrapolation mode = noExtrapolation);
+
+      /**
+       * Construct an interpolator over a view of a set of positions.
+       *
+       * @param positions A view of the x, y, and z coordinates.
+       * @param times The time of each position. Must be strictly increasing.
+       * @param interp The interpolation type. Hermite interpolation is not
+       *               supported because there are no velocities.
+       * @param mode How times outside of the positions are handled.
+       */
+      StateInterpolator(const MatrixView& positions, const DataView& times,
+                        interpolation interp, extrapolation mode = noExtrapolation);
+      StateInterpolator(const MatrixView& positions, const UniformTimeGrid& times,
+                        interpolation interp, extrapolation mode = noExtrapolation);
+
+      /**
+       * Get the position at a time.
+       *
+       * @param time The time to get the position at.
+       * @param position Output array for the x, y, and z position.
+       *
+       * @return How the time was evaluated. If it is outOfRange, nothing is written.
+       */
+      evaluationStatus position(double time, double *position) noexcept;
+
+      /**
+       * Get the velocity at a time.
+       *
+       * @param time The time to get the velocity at.
+       * @param velocity Output array for the x, y, and z velocity.
+       *
+       * @return How the time was evaluated. If it is outOfRange, nothing is written.
+       */
+      evaluationStatus velocity(double time, double *velocity) noexcept;
+
+      /**
+       * Get the position and velocity at a time.
+       *
+       * @param time The time to get the state at.
+       * @param position Output array for the x, y, and z position.
+       * @param velocity Output array for the x, y, and z velocity. Can be
+       *                 null if it is not needed.
+       *
+       * @return How the time was evaluated. If it is outOfRange, nothing is written.
+       */
+      evaluationStatus state(double time, double *position, double *velocity) noexcept;
+
+      /**
+       * Get the positions and velocities at a set of times.
+       *
+       * @param times The times to get the states at.
+       * @param numTimes The number of times.
+       * @param positions Output array for the positions, 3 * numTimes doubles
+       *                  ordered x, y, z for each time. Can be null if only
+       *                  the velocities are needed.
+       * @param velocities Output array for the velocities, 3 * numTimes doubles
+       *                   ordered x, y, z for each time. Can be null if they
+       *                   are not needed.
+       *
+       * @return The worst status of all of the times. Times that are
+       *         outOfRange are skipped.
+       */
+      evaluationStatus states(const double *times, size_t numTimes,
+                              double *positions, double *velocities) noexcept;
+
+    private:
+      PiecewisePolynomial m_positions;
+  };
+}
+
+#endif
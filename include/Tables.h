@@ -0,0 +1,354 @@
+#ifndef ALE_TABLES_H
+#define ALE_TABLES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "DataView.h"
+#include "UniformTimeGrid.h"
+
+namespace ale {
+
+  /**
+   * An allocator that aligns the start of its storage.
+   *
+   * Aligned storage lets vectorized code load whole registers at a time.
+   */
+  template <typename T, size_t Alignment>
+  class AlignedAllocator {
+    public:
+      typedef T value_type;
+
+      template <typename U>
+      struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;
+      };
+
+      AlignedAllocator() noexcept { }
+
+      template <typename U>
+      AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept { }
+
+      T *allocate(size_t n) {
+        // Over allocate so that the block can be aligned and the original
+        // pointer can be stored right in front of it.
+        void *raw = ::operator new(n * sizeof(T) + Alignment + sizeof(void *));
+        uintptr_t start = reinterpret_cast<uintptr_t>(raw) + sizeof(void *);
+        uintptr_t aligned = (start + Alignment - 1) & ~static_cast<uintptr_t>(Alignment - 1);
+        reinterpret_cast<void **>(aligned)[-1] = raw;
+        return reinterpret_cast<T *>(aligned);
+      }
+
+      void deallocate(T *p, size_t) noexcept {
+        ::operator delete(reinterpret_cast<void **>(p)[-1]);
+      }
+  };
+
+  template <typename T, typename U, size_t Alignment>
+  bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) {
+    return true;
+  }
+
+  template <typename T, typename U, size_t Alignment>
+  bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) {
+    return false;
+  }
+
+  /**
+   * Column-major storage for a set of values sampled at a set of times.
+   *
+   * The times and every value column are stored in a single allocation. Each
+   * column is contiguous and starts on a 64 byte boundary. If the samples are
+   * on a UniformTimeGrid, the times are not stored at all.
+   */
+  class SampledTable {
+    public:
+      /**
+       * The number of samples in the table.
+       */
+      size_t size() const {
+        return m_size;
+      }
+
+      /**
+       * If the samples are on a uniform time grid instead of stored times.
+       */
+      bool isUniform() const {
+        return m_uniform;
+      }
+
+      /**
+       * The uniform time grid of the samples. Only valid for uniform tables.
+       */
+      const UniformTimeGrid &grid() const {
+        return m_grid;
+      }
+
+      /**
+       * The time of each sample. Uniform tables do not store their times, so
+       * this is null for them.
+       */
+      double *times() {
+        return column(0);
+      }
+
+      const double *times() const {
+        return column(0);
+      }
+
+      /**
+       * A view of the time of each sample. This is empty for uniform tables.
+       */
+      DataView timesView() const {
+        return m_uniform ? DataView(nullptr, 0) : DataView(times(), m_size);
+      }
+
+    protected:
+      /**
+       * Allocate a zero filled table.
+       *
+       * @param numSamples The number of samples.
+       * @param numColumns The number of value columns, not including the times.
+       */
+      SampledTable(size_t numSamples, size_t numColumns);
+      /**
+       * Allocate a zero filled table on a uniform time grid.
+       *
+       * @param grid The time of each sample.
+       * @param numColumns The number of value columns.
+       */
+      SampledTable(const UniformTimeGrid& grid, size_t numColumns);
+
+      /**
+       * Get a column of the table. Column 0 is the times, which are not
+       * stored for uniform tables, so it is null for them.
+       */
+      double *column(size_t index) {
+        if (!m_uniform) {
+          return m_data.data() + index * m_columnStride;
+        }
+        return index == 0 ? nullptr : m_data.data() + (index - 1) * m_columnStride;
+      }
+
+      const double *column(size_t index) const {
+        if (!m_uniform) {
+          return m_data.data() + index * m_columnStride;
+        }
+        return index == 0 ? nullptr : m_data.data() + (index - 1) * m_columnStride;
+      }
+
+      /**
+       * View a range of consecutive columns as a set of components.
+       */
+      MatrixView columnsView(size_t first, size_t count) const {
+        return MatrixView(column(first), count, m_size, m_columnStride, 1);
+      }
+
+      /**
+       * Copy a set of component vectors into consecutive columns.
+       */
+      void setColumns(size_t first, const std::vector<std::vector<double>>& components);
+
+    private:
+      // The number of samples
+      size_t m_size;
+      // If the times are a uniform grid instead of the first column
+      bool m_uniform;
+      UniformTimeGrid m_grid;
+      // The distance between the start of each column, in doubles
+      size_t m_columnStride;
+      // The times followed by each value column
+      std::vector<double, AlignedAllocator<double, 64>> m_data;
+  };
+
+  /**
+   * A table of positions and, optionally, velocities at a set of times.
+   */
+  class StateTable : public SampledTable {
+    public:
+      /**
+       * Allocate a zero filled table to be filled in through the column accessors.
+       *
+       * @param numStates The number of states in the table.
+       * @param hasVelocities If the table stores velocities.
+       */
+      explicit StateTable(size_t numStates = 0, bool hasVelocities = true);
+      /**
+       * Construct a table by copying a set of times, positions, and velocities.
+       *
+       * @param times The time of each state. Must be sorted in ascending order.
+       * @param positions The x, y, and z position vectors.
+       * @param velocities The x, y, and z velocity vectors. If empty, the table
+       *                   does not store velocities.
+       */
+      StateTable(const std::vector<double>& times,
+                 const std::vector<std::vector<double>>& positions,
+                 const std::vector<std::vector<double>>& velocities = {});
+      /**
+       * Allocate a zero filled table on a uniform time grid. No times are stored.
+       *
+       * @param grid The time of each state.
+       * @param hasVelocities If the table stores velocities.
+       */
+      explicit StateTable(const UniformTimeGrid& grid, bool hasVelocities = true);
+      /**
+       * Construct a table on a uniform time grid by copying a set of positions
+       * and velocities.
+       *
+       * @param grid The time of each state.
+       * @param positions The x, y, and z position vectors.
+       * @param velocities The x, y, and z velocity vectors. If empty, the table
+       *                   does not store velocities.
+       */
+      StateTable(const UniformTimeGrid& grid,
+                 const std::vector<std::vector<double>>& positions,
+                 const std::vector<std::vector<double>>& velocities = {});
+
+      /**
+       * If the table stores velocities.
+       */
+      bool hasVelocities() const {
+        return m_hasVelocities;
+      }
+
+      /**
+       * The position of each state along an axis. 0 is X, 1 is Y, and 2 is Z.
+       */
+      double *positions(int axis) {
+        return column(1 + axis);
+      }
+
+      const double *positions(int axis) const {
+        return column(1 + axis);
+      }
+
+      /**
+       * The velocity of each state along an axis. 0 is X, 1 is Y, and 2 is Z.
+       * Null if the table does not store velocities.
+       */
+      double *velocities(int axis) {
+        return m_hasVelocities ? column(4 + axis) : nullptr;
+      }
+
+      const double *velocities(int axis) const {
+        return m_hasVelocities ? column(4 + axis) : nullptr;
+      }
+
+      /**
+       * A view of the x, y, and z positions.
+       */
+      MatrixView positionsView() const {
+        return columnsView(1, 3);
+      }
+
+      /**
+       * A view of the x, y, and z velocities.
+       * Only valid if the table stores velocities.
+       */
+      MatrixView velocitiesView() const {
+        return columnsView(4, 3);
+      }
+
+    private:
+      bool m_hasVelocities;
+  };
+
+  /**
+   * A table of quaternions and, optionally, angular velocities at a set of times.
+   *
+   * Angular velocities are expected in the destination frame, like those of
+   * TimeDependentRotation and SPICE's xf2rav. See angularVelocityConvention.
+   */
+  class QuaternionTable : public SampledTable {
+    public:
+      /**
+       * Allocate a zero filled table to be filled in through the column accessors.
+       *
+       * @param numRotations The number of rotations in the table.
+       * @param hasAngularVelocities If the table stores angular velocities.
+       */
+      explicit QuaternionTable(size_t numRotations = 0, bool hasAngularVelocities = false);
+      /**
+       * Construct a table by copying a set of times, quaternions, and angular velocities.
+       *
+       * @param times The time of each rotation. Must be sorted in ascending order.
+       * @param quaternions The w, x, y, and z quaternion component vectors.
+       * @param angularVelocities The x, y, and z angular velocity vectors. If
+       *                          empty, the table does not store angular velocities.
+       */
+      QuaternionTable(const std::vector<double>& times,
+                      const std::vector<std::vector<double>>& quaternions,
+                      const std::vector<std::vector<double>>& angularVelocities = {});
+      /**
+       * Allocate a zero filled table on a uniform time grid. No times are stored.
+       *
+       * @param grid The time of each rotation.
+       * @param hasAngularVelocities If the table stores angular velocities.
+       */
+      explicit QuaternionTable(const UniformTimeGrid& grid, bool hasAngularVelocities = false);
+      /**
+       * Construct a table on a uniform time grid by copying a set of
+       * quaternions and angular velocities.
+       *
+       * @param grid The time of each rotation.
+       * @param quaternions The w, x, y, and z quaternion component vectors.
+       * @param angularVelocities The x, y, and z angular velocity vectors. If
+       *                          empty, the table does not store angular velocities.
+       */
+      QuaternionTable(const UniformTimeGrid& grid,
+                      const std::vector<std::vector<double>>& quaternions,
+                      const std::vector<std::vector<double>>& angularVelocities = {});
+
+      /**
+       * If the table stores angular velocities.
+       */
+      bool hasAngularVelocities() const {
+        return m_hasAngularVelocities;
+      }
+
+      /**
+       * A quaternion component of each rotation. 0 is W, 1 is X, 2 is Y, and 3 is Z.
+       */
+      double *quaternions(int component) {
+        return column(1 + component);
+      }
+
+      const double *quaternions(int component) const {
+        return column(1 + component);
+      }
+
+      /**
+       * The angular velocity of each rotation about an axis. 0 is X, 1 is Y,
+       * and 2 is Z. Null if the table does not store angular velocities.
+       */
+      double *angularVelocities(int axis) {
+        return m_hasAngularVelocities ? column(5 + axis) : nullptr;
+      }
+
+      const double *angularVelocities(int axis) const {
+        return m_hasAngularVelocities ? column(5 + axis) : nullptr;
+      }
+
+      /**
+       * A view of the w, x, y, and z quaternion components.
+       */
+      MatrixView quaternionsView() const {
+        return columnsView(1, 4);
+      }
+
+      /**
+       * A view of the x, y, and z angular velocities.
+       * Only valid if the table stores angular velocities.
+       */
+      MatrixView angularVelocitiesView() const {
+        return columnsView(5, 3);
+      }
+
+    private:
+      bool m_hasAngularVelocities;
+  };
+}
+
+#endif
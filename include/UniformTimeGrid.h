@@ -0,0 +1,93 @@
+#ifndef ALE_UNIFORMTIMEGRID_H
+#define ALE_UNIFORMTIMEGRID_H
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+namespace ale {
+
+  /**
+   * A set of evenly spaced times, where time i is start + i * step.
+   *
+   * Only the start, step, and number of times are stored. The interval that
+   * contains a time is computed directly instead of being searched for.
+   * Line scanner ISDs are sampled this way, see t0_ephemeris, dt_ephemeris,
+   * t0_quaternion, and dt_quaternion.
+   */
+  class UniformTimeGrid {
+    public:
+      /**
+       * Construct an empty grid.
+       */
+      UniformTimeGrid() : m_start(0), m_step(1), m_size(0) { }
+
+      /**
+       * Construct a grid.
+       *
+       * @param start The first time.
+       * @param step The time between consecutive times. Must be positive.
+       * @param size The number of times.
+       */
+      UniformTimeGrid(double start, double step, size_t size) :
+            m_start(start), m_step(step), m_size(size) {
+        if (!(step > 0)) {
+          throw std::invalid_argument("Invalid time grid step, must be positive.");
+        }
+      }
+
+      /**
+       * Get a time in the grid.
+       */
+      double operator[](size_t index) const {
+        return m_start + index * m_step;
+      }
+
+      double front() const {
+        return m_start;
+      }
+
+      double back() const {
+        return (*this)[m_size - 1];
+      }
+
+      double start() const {
+        return m_start;
+      }
+
+      double step() const {
+        return m_step;
+      }
+
+      size_t size() const {
+        return m_size;
+      }
+
+      /**
+       * Find the interval that contains a time.
+       *
+       * @param time The time to find. The grid must have at least two times.
+       *
+       * @return The index i in [0, size - 2] such that time i <= time < time i + 1,
+       *         clamped to the first and last intervals.
+       */
+      size_t interval(double time) const {
+        double index = std::floor((time - m_start) / m_step);
+        size_t last = m_size - 2;
+        if (!(index > 0)) {
+          return 0;
+        }
+        if (index >= last) {
+          return last;
+        }
+        return static_cast<size_t>(index);
+      }
+
+    private:
+      double m_start;
+      double m_step;
+      size_t m_size;
+  };
+}
+
+#endif
@@ -8,18 +8,21 @@
 #include <gsl/gsl_interp.h>
  
 #include <nlohmann/json.hpp>
+
+#include "DataView.h"
+#include "Interpolator.h"
+#include "PiecewisePolynomial.h"
+#include "Polynomial.h"
+#include "RotationInterpolator.h"
+#include "RotationTable.h"
+#include "StateInterpolator.h"
+#include "Tables.h"
+#include "UniformTimeGrid.h"
+
 using json = nlohmann::json;
 
 namespace ale {
 
-  /// Interpolation enum for defining different methods of interpolation
-  enum interpolation {
-    /// Interpolate using linear interpolation
-    linear,
-    /// Interpolate using spline interpolation
-    spline
-  };
-
   /**
    *@brief Get the position of the spacecraft at a given time based on a set of coordinates, and their associated times
    *@param coords A vector of double vectors of coordinates
@@ -28,8 +31,8 @@ namespace ale {
    *@param interp Interpolation type
    *@return A vector double of the spacecrafts position
    */
-  std::vector<double> getPosition(std::vector<std::vector<double>> coords,
-                                  std::vector<double> times,
+  std::vector<double> getPosition(const std::vector<std::vector<double>>& coords,
+                                  const std::vector<double>& times,
                                   double time, interpolation interp);
   /**
    *@brief Get the velocity of the spacecraft at a given time based on a set of coordinates, and their associated times
@@ -39,16 +42,242 @@ namespace ale {
    *@param interp Interpolation type
    *@return A vector double of the spacecrafts velocity
    */
-  std::vector<double> getVelocity(std::vector<std::vector<double>> coords,
-                                  std::vector<double> times,
-                                  double time, const interpolation interp);
+  std::vector<double> getVelocity(const std::vector<std::vector<double>>& coords,
+                                  const std::vector<double>& times,
+                                  double time, interpolation interp);
+  /**
+   *@brief Get the positions of the spacecraft at a set of times based on a set of coordinates, and their associated times
+   *@param coords A vector of double vectors of coordinates
+   *@param times A double vector of times
+   *@param queryTimes Times to observe the spacecraft's position at, sorted in ascending order
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type
+   *@param positions Output array for the positions, 3 * numQueries doubles
+                     ordered x, y, z for each query time
+   */
+  void getPosition(const std::vector<std::vector<double>>& coords,
+                   const std::vector<double>& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *positions);
+
+  /**
+   *@brief Get the velocities of the spacecraft at a set of times based on a set of coordinates, and their associated times
+   *@param coords A vector of double vectors of coordinates
+   *@param times A double vector of times
+   *@param queryTimes Times to observe the spacecraft's velocity at, sorted in ascending order
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type
+   *@param velocities Output array for the velocities, 3 * numQueries doubles
+                      ordered x, y, z for each query time
+   */
+  void getVelocity(const std::vector<std::vector<double>>& coords,
+                   const std::vector<double>& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *velocities);
+
+  /**
+   *@brief Get the position of the spacecraft at a given time from views of a set of coordinates, and their associated times
+   *@param coords A view of the x, y, and z coordinates
+   *@param times A view of the times
+   *@param time Time to observe the spacecraft's position at
+   *@param interp Interpolation type
+   *@return A vector double of the spacecrafts position
+   */
+  std::vector<double> getPosition(const MatrixView& coords, const DataView& times,
+                                  double time, interpolation interp);
+
+  /**
+   *@brief Get the velocity of the spacecraft at a given time from views of a set of coordinates, and their associated times
+   *@param coords A view of the x, y, and z coordinates
+   *@param times A view of the times
+   *@param time Time to observe the spacecraft's velocity at
+   *@param interp Interpolation type
+   *@return A vector double of the spacecrafts velocity
+   */
+  std::vector<double> getVelocity(const MatrixView& coords, const DataView& times,
+                                  double time, interpolation interp);
+
+  /**
+   *@brief Get the positions of the spacecraft at a set of times from views of a set of coordinates, and their associated times
+   *@param coords A view of the x, y, and z coordinates
+   *@param times A view of the times
+   *@param queryTimes Times to observe the spacecraft's position at, sorted in ascending order
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type
+   *@param positions Output array for the positions, 3 * numQueries doubles
+                     ordered x, y, z for each query time
+   */
+  void getPosition(const MatrixView& coords, const DataView& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *positions);
+
+  /**
+   *@brief Get the velocities of the spacecraft at a set of times from views of a set of coordinates, and their associated times
+   *@param coords A view of the x, y, and z coordinates
+   *@param times A view of the times
+   *@param queryTimes Times to observe the spacecraft's velocity at, sorted in ascending order
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type
+   *@param velocities Output array for the velocities, 3 * numQueries doubles
+                      ordered x, y, z for each query time
+   */
+  void getVelocity(const MatrixView& coords, const DataView& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *velocities);
+
+  /**
+   *@brief Get the position of the spacecraft at a given time from a view of a set of coordinates on a uniform time grid
+   *@param coords A view of the x, y, and z coordinates
+   *@param times The uniform time grid of the coordinates
+   *@param time Time to observe the spacecraft's position at
+   *@param interp Interpolation type
+   *@return A vector double of the spacecrafts position
+   */
+  std::vector<double> getPosition(const MatrixView& coords, const UniformTimeGrid& times,
+                                  double time, interpolation interp);
+
+  /**
+   *@brief Get the velocity of the spacecraft at a given time from a view of a set of coordinates on a uniform time grid
+   *@param coords A view of the x, y, and z coordinates
+   *@param times The uniform time grid of the coordinates
+   *@param time Time to observe the spacecraft's velocity at
+   *@param interp Interpolation type
+   *@return A vector double of the spacecrafts velocity
+   */
+  std::vector<double> getVelocity(const MatrixView& coords, const UniformTimeGrid& times,
+                                  double time, interpolation interp);
+
+  /**
+   *@brief Get the positions of the spacecraft at a set of times from a view of a set of coordinates on a uniform time grid
+   *@param coords A view of the x, y, and z coordinates
+   *@param times The uniform time grid of the coordinates
+   *@param queryTimes Times to observe the spacecraft's position at
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type
+   *@param positions Output array for the positions, 3 * numQueries doubles
+                     ordered x, y, z for each query time
+   */
+  void getPosition(const MatrixView& coords, const UniformTimeGrid& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *positions);
+
+  /**
+   *@brief Get the velocities of the spacecraft at a set of times from a view of a set of coordinates on a uniform time grid
+   *@param coords A view of the x, y, and z coordinates
+   *@param times The uniform time grid of the coordinates
+   *@param queryTimes Times to observe the spacecraft's velocity at
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type
+   *@param velocities Output array for the velocities, 3 * numQueries doubles
+                      ordered x, y, z for each query time
+   */
+  void getVelocity(const MatrixView& coords, const UniformTimeGrid& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *velocities);
+
+  /**
+   *@brief Get the position of the spacecraft at a given time from a table of states
+   *@param states The table of states
+   *@param time Time to observe the spacecraft's position at
+   *@param interp Interpolation type. Hermite interpolation requires the
+                  table to store velocities.
+   *@return A vector double of the spacecrafts position
+   */
+  std::vector<double> getPosition(const StateTable& states, double time, interpolation interp);
+
+  /**
+   *@brief Get the velocity of the spacecraft at a given time from a table of states
+   *@param states The table of states
+   *@param time Time to observe the spacecraft's velocity at
+   *@param interp Interpolation type
+   *@return A vector double of the spacecrafts velocity
+   */
+  std::vector<double> getVelocity(const StateTable& states, double time, interpolation interp);
+
+  /**
+   *@brief Get the positions of the spacecraft at a set of times from a table of states
+   *@param states The table of states
+   *@param queryTimes Times to observe the spacecraft's position at, sorted in ascending order
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type
+   *@param positions Output array for the positions, 3 * numQueries doubles
+                     ordered x, y, z for each query time
+   */
+  void getPosition(const StateTable& states,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *positions);
+
+  /**
+   *@brief Get the velocities of the spacecraft at a set of times from a table of states
+   *@param states The table of states
+   *@param queryTimes Times to observe the spacecraft's velocity at, sorted in ascending order
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type
+   *@param velocities Output array for the velocities, 3 * numQueries doubles
+                      ordered x, y, z for each query time
+   */
+  void getVelocity(const StateTable& states,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *velocities);
+
+  /**
+   *@brief Get the positions and velocities of the spacecraft at a set of times from a view of a set of coordinates, and their associated times
+   *@param coords A view of the x, y, and z coordinates
+   *@param times A view of the times
+   *@param queryTimes Times to observe the spacecraft's state at
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type. All three axes are evaluated together
+                  and the velocities come from the same evaluation as the positions.
+   *@param positions Output array for the positions, 3 * numQueries doubles
+                     ordered x, y, z for each query time. Can be null.
+   *@param velocities Output array for the velocities, 3 * numQueries doubles
+                      ordered x, y, z for each query time. Can be null.
+   */
+  void getState(const MatrixView& coords, const DataView& times,
+                const double *queryTimes, size_t numQueries,
+                interpolation interp, double *positions, double *velocities);
+
+  /**
+   *@brief Get the positions and velocities of the spacecraft at a set of times from a view of a set of coordinates on a uniform time grid
+   *@param coords A view of the x, y, and z coordinates
+   *@param times The uniform time grid of the coordinates
+   *@param queryTimes Times to observe the spacecraft's state at
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type
+   *@param positions Output array for the positions, 3 * numQueries doubles
+                     ordered x, y, z for each query time. Can be null.
+   *@param velocities Output array for the velocities, 3 * numQueries doubles
+                      ordered x, y, z for each query time. Can be null.
+   */
+  void getState(const MatrixView& coords, const UniformTimeGrid& times,
+                const double *queryTimes, size_t numQueries,
+                interpolation interp, double *positions, double *velocities);
+
+  /**
+   *@brief Get the positions and velocities of the spacecraft at a set of times from a table of states
+   *@param states The table of states
+   *@param queryTimes Times to observe the spacecraft's state at, sorted in ascending order
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type. Hermite interpolation evaluates the
+                  positions and velocities together in a single pass.
+   *@param positions Output array for the positions, 3 * numQueries doubles
+                     ordered x, y, z for each query time
+   *@param velocities Output array for the velocities, 3 * numQueries doubles
+                      ordered x, y, z for each query time
+   */
+  void getState(const StateTable& states,
+                const double *queryTimes, size_t numQueries,
+                interpolation interp, double *positions, double *velocities);
+
+
+
   /**
    *@brief Get the position of the spacecraft at a given time based on a derived function from a set of coeffcients
    *@param coeffs A vector of double vector of coeffcients
    *@param time Time to observe the spacecraft's position at
    *@return A vector double of the spacecrafts position
    */
-  std::vector<double> getPosition(std::vector<std::vector<double>> coeffs, double time);
+  std::vector<double> getPosition(const std::vector<std::vector<double>>& coeffs, double time);
 
   /**
    *@brief Get the velocity of the spacecraft at a given time based on a derived function from a set of coeffcients
@@ -56,7 +285,29 @@ namespace ale {
    *@param time Time to observe the spacecraft's velocity at
    *@return A vector double of the spacecrafts velocity
    */
-  std::vector<double> getVelocity(std::vector<std::vector<double>> coeffs, double time);
+  std::vector<double> getVelocity(const std::vector<std::vector<double>>& coeffs, double time);
+
+  /**
+   *@brief Get the positions of the spacecraft at a set of times based on a derived function from a set of coeffcients
+   *@param coeffs A vector of double vector of coeffcients
+   *@param times Times to observe the spacecraft's position at
+   *@param numTimes The number of times in times
+   *@param positions Output array for the positions, 3 * numTimes doubles
+                     ordered x, y, z for each time
+   */
+  void getPosition(const std::vector<std::vector<double>>& coeffs,
+                   const double *times, size_t numTimes, double *positions);
+
+  /**
+   *@brief Get the velocities of the spacecraft at a set of times based on a derived function from a set of coeffcients
+   *@param coeffs A vector of double vector of coeffcients
+   *@param times Times to observe the spacecraft's velocity at
+   *@param numTimes The number of times in times
+   *@param velocities Output array for the velocities, 3 * numTimes doubles
+                      ordered x, y, z for each time
+   */
+  void getVelocity(const std::vector<std::vector<double>>& coeffs,
+                   const double *times, size_t numTimes, double *velocities);
 
   /**
    *@brief Get the rotation of the spacecraft at a given time based on a set of rotations, and their associated times
@@ -66,10 +317,103 @@ namespace ale {
    *@param interp Interpolation type
    *@return A vector double of the spacecrafts rotation
    */
-  std::vector<double> getRotation(std::vector<std::vector<double>> rotations,
-                                  std::vector<double> times,
+  std::vector<double> getRotation(const std::vector<std::vector<double>>& rotations,
+                                  const std::vector<double>& times,
+                                  double time, interpolation interp);
+
+  /**
+   *@brief Get the rotations of the spacecraft at a set of times based on a set of rotations, and their associated times
+   *@param rotations A vector of double vector of rotations
+   *@param times A double vector of times
+   *@param queryTimes Times to observe the spacecraft's rotation at, sorted in ascending order
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type
+   *@param quaternions Output array for the rotations, 4 * numQueries doubles
+                       ordered w, x, y, z for each query time
+   */
+  void getRotation(const std::vector<std::vector<double>>& rotations,
+                   const std::vector<double>& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *quaternions);
+
+  /**
+   *@brief Get the rotation of the spacecraft at a given time from views of a set of rotations, and their associated times
+   *@param rotations A view of the w, x, y, and z quaternion components
+   *@param times A view of the times
+   *@param time Time to observe the spacecraft's rotation at
+   *@param interp Interpolation type
+   *@return A vector double of the spacecrafts rotation
+   */
+  std::vector<double> getRotation(const MatrixView& rotations, const DataView& times,
+                                  double time, interpolation interp);
+
+  /**
+   *@brief Get the rotations of the spacecraft at a set of times from views of a set of rotations, and their associated times
+   *@param rotations A view of the w, x, y, and z quaternion components
+   *@param times A view of the times
+   *@param queryTimes Times to observe the spacecraft's rotation at, sorted in ascending order
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type
+   *@param quaternions Output array for the rotations, 4 * numQueries doubles
+                       ordered w, x, y, z for each query time
+   */
+  void getRotation(const MatrixView& rotations, const DataView& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *quaternions);
+
+  /**
+   *@brief Get the rotation of the spacecraft at a given time from a view of a set of rotations on a uniform time grid
+   *@param rotations A view of the w, x, y, and z quaternion components
+   *@param times The uniform time grid of the rotations
+   *@param time Time to observe the spacecraft's rotation at
+   *@param interp Interpolation type
+   *@return A vector double of the spacecrafts rotation
+   */
+  std::vector<double> getRotation(const MatrixView& rotations, const UniformTimeGrid& times,
                                   double time, interpolation interp);
 
+  /**
+   *@brief Get the rotations of the spacecraft at a set of times from a view of a set of rotations on a uniform time grid
+   *@param rotations A view of the w, x, y, and z quaternion components
+   *@param times The uniform time grid of the rotations
+   *@param queryTimes Times to observe the spacecraft's rotation at
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type
+   *@param quaternions Output array for the rotations, 4 * numQueries doubles
+                       ordered w, x, y, z for each query time
+   */
+  void getRotation(const MatrixView& rotations, const UniformTimeGrid& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *quaternions);
+
+  /**
+   *@brief Get the rotation of the spacecraft at a given time from a table of quaternions
+   *@param rotations The table of quaternions
+   *@param time Time to observe the spacecraft's rotation at
+   *@param interp Interpolation type. Hermite interpolation requires the
+                  table to store angular velocities, in the destination
+                  frame like TimeDependentRotation's.
+   *@return A vector double of the spacecrafts rotation
+   */
+  std::vector<double> getRotation(const QuaternionTable& rotations, double time, interpolation interp);
+
+  /**
+   *@brief Get the rotations of the spacecraft at a set of times from a table of quaternions
+   *@param rotations The table of quaternions
+   *@param queryTimes Times to observe the spacecraft's rotation at, sorted in ascending order
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type. Hermite interpolation requires the
+                  table to store angular velocities, in the destination
+                  frame like TimeDependentRotation's.
+   *@param quaternions Output array for the rotations, 4 * numQueries doubles
+                       ordered w, x, y, z for each query time
+   */
+  void getRotation(const QuaternionTable& rotations,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *quaternions);
+
+
+
   /**
    *@brief Get the angular velocity of the spacecraft at a given time based on a set of rotations, and their associated times
    *@param rotations A vector of double vector of rotations
@@ -78,17 +422,113 @@ namespace ale {
    *@param interp Interpolation type
    *@return A vector double of the spacecrafts angular velocity
    */
-  std::vector<double> getAngularVelocity(std::vector<std::vector<double>> rotations,
-                                         std::vector<double> times,
+  std::vector<double> getAngularVelocity(const std::vector<std::vector<double>>& rotations,
+                                         const std::vector<double>& times,
                                          double time, interpolation interp);
 
+  /**
+   *@brief Get the angular velocity of the spacecraft at a given time from views of a set of rotations, and their associated times
+   *@param rotations A view of the w, x, y, and z quaternion components
+   *@param times A view of the times
+   *@param time Time to observe the spacecraft's angular velocity at
+   *@param interp Interpolation type
+   *@return A vector double of the spacecrafts angular velocity
+   */
+  std::vector<double> getAngularVelocity(const MatrixView& rotations, const DataView& times,
+                                         double time, interpolation interp);
+
+  /**
+   *@brief Get the angular velocity of the spacecraft at a given time from a view of a set of rotations on a uniform time grid
+   *@param rotations A view of the w, x, y, and z quaternion components
+   *@param times The uniform time grid of the rotations
+   *@param time Time to observe the spacecraft's angular velocity at
+   *@param interp Interpolation type
+   *@return A vector double of the spacecrafts angular velocity
+   */
+  std::vector<double> getAngularVelocity(const MatrixView& rotations, const UniformTimeGrid& times,
+                                         double time, interpolation interp);
+
+  /**
+   *@brief Get the angular velocity of the spacecraft at a given time from a table of quaternions
+   *@param rotations The table of quaternions
+   *@param time Time to observe the spacecraft's angular velocity at
+   *@param interp Interpolation type. Hermite interpolation requires the
+                  table to store angular velocities, in the destination
+                  frame like TimeDependentRotation's.
+   *@return A vector double of the spacecrafts angular velocity
+   */
+  std::vector<double> getAngularVelocity(const QuaternionTable& rotations, double time, interpolation interp);
+
+  /**
+   *@brief Get the rotations and angular velocities of the spacecraft at a set of times from views of a set of rotations, and their associated times
+   *@param rotations A view of the w, x, y, and z quaternion components
+   *@param times A view of the times
+   *@param queryTimes Times to observe the spacecraft's rotation at
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type. Each rotation and its derivative come
+                  from a single evaluation of all four components.
+   *@param quaternions Output array for the rotations, 4 * numQueries doubles
+                       ordered w, x, y, z for each query time. Can be null.
+   *@param angularVelocities Output array for the angular velocities, 3 * numQueries
+                             doubles ordered x, y, z for each query time. Can be null.
+   */
+  void getRotationState(const MatrixView& rotations, const DataView& times,
+                        const double *queryTimes, size_t numQueries, interpolation interp,
+                        double *quaternions, double *angularVelocities);
+
+  /**
+   *@brief Get the rotations and angular velocities of the spacecraft at a set of times from a view of a set of rotations on a uniform time grid
+   *@param rotations A view of the w, x, y, and z quaternion components
+   *@param times The uniform time grid of the rotations
+   *@param queryTimes Times to observe the spacecraft's rotation at
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type
+   *@param quaternions Output array for the rotations, 4 * numQueries doubles
+                       ordered w, x, y, z for each query time. Can be null.
+   *@param angularVelocities Output array for the angular velocities, 3 * numQueries
+                             doubles ordered x, y, z for each query time. Can be null.
+   */
+  void getRotationState(const MatrixView& rotations, const UniformTimeGrid& times,
+                        const double *queryTimes, size_t numQueries, interpolation interp,
+                        double *quaternions, double *angularVelocities);
+
+  /**
+   *@brief Get the rotations and angular velocities of the spacecraft at a set of times from a table of quaternions
+   *@param rotations The table of quaternions
+   *@param queryTimes Times to observe the spacecraft's rotation at
+   *@param numQueries The number of times in queryTimes
+   *@param interp Interpolation type. Hermite interpolation requires the
+                  table to store angular velocities, in the destination
+                  frame like TimeDependentRotation's.
+   *@param quaternions Output array for the rotations, 4 * numQueries doubles
+                       ordered w, x, y, z for each query time. Can be null.
+   *@param angularVelocities Output array for the angular velocities, 3 * numQueries
+                             doubles ordered x, y, z for each query time. Can be null.
+   */
+  void getRotationState(const QuaternionTable& rotations,
+                        const double *queryTimes, size_t numQueries, interpolation interp,
+                        double *quaternions, double *angularVelocities);
+
+
+
    /**
     *@brief Get the rotation of the spacecraft at a given time based on a derived function from a set of coeffcients
     *@param coeffs A vector of double vector of coeffcients
     *@param time Time to observe the spacecraft's rotation at
     *@return A vector double of the spacecrafts rotation
     */
-  std::vector<double> getRotation(std::vector<std::vector<double>> coeffs, double time);
+  std::vector<double> getRotation(const std::vector<std::vector<double>>& coeffs, double time);
+
+  /**
+   *@brief Get the rotations of the spacecraft at a set of times based on a derived function from a set of coeffcients
+   *@param coeffs A vector of double vector of coeffcients
+   *@param times Times to observe the spacecraft's rotation at
+   *@param numTimes The number of times in times
+   *@param quaternions Output array for the rotations, 4 * numTimes doubles
+                       ordered w, x, y, z for each time
+   */
+  void getRotation(const std::vector<std::vector<double>>& coeffs,
+                   const double *times, size_t numTimes, double *quaternions);
 
   /**
    *@brief Get the angular velocity of the spacecraft at a given time based on a derived function from a set of coeffcients
@@ -96,7 +536,18 @@ namespace ale {
    *@param time Time to observe the spacecraft's angular velocity at
    *@return A vector double of the spacecrafts angular velocity
    */
-  std::vector<double> getAngularVelocity(std::vector<std::vector<double>> coeffs, double time);
+  std::vector<double> getAngularVelocity(const std::vector<std::vector<double>>& coeffs, double time);
+
+  /**
+   *@brief Get the angular velocities of the spacecraft at a set of times based on a derived function from a set of coeffcients
+   *@param coeffs A vector of double vector of coeffcients
+   *@param times Times to observe the spacecraft's angular velocity at
+   *@param numTimes The number of times in times
+   *@param angularVelocities Output array for the angular velocities,
+                             3 * numTimes doubles ordered x, y, z for each time
+   */
+  void getAngularVelocity(const std::vector<std::vector<double>>& coeffs,
+                          const double *times, size_t numTimes, double *angularVelocities);
 
   /**
    *@brief Generates a derivatives in respect to time from a polynomial constructed using the given coeffcients, time, and derivation number
@@ -105,7 +556,7 @@ namespace ale {
    *@param d The order of the derivative to generate (Currently supports 0, 1, and 2)
    *@return Evalutation of the given polynomial as a double
    */
-  double evaluatePolynomial(std::vector<double> coeffs, double time, int d);
+  double evaluatePolynomial(const std::vector<double>& coeffs, double time, int d);
 
   /**
    *@brief Interpolates the spacecrafts position along a path generated from a set of points,
@@ -118,7 +569,19 @@ namespace ale {
                       (Currently supports 0, 1, and 2)
    *@return
    */
-  double interpolate(std::vector<double> points, std::vector<double> times, double time, interpolation interp, int d);
+  double interpolate(const std::vector<double>& points, const std::vector<double>& times, double time, interpolation interp, int d);
+
+  /**
+   *@brief Interpolates a value from a view of a set of points and times without copying them
+   *@param points A view of the points
+   *@param times A view of the times
+   *@param time A double to use as the time of observation
+   *@param interp An interpolation enum dictating what type of interpolation to use
+   *@param d The order of the derivative to generate when interpolating
+                      (Currently supports 0, 1, and 2)
+   *@return The interpolated value
+   */
+  double interpolate(const DataView& points, const DataView& times, double time, interpolation interp, int d);
   std::string loads(std::string filename, std::string props="", std::string formatter="usgscsm", bool verbose=true);
 
   json load(std::string filename, std::string props="", std::string formatter="usgscsm", bool verbose=true);
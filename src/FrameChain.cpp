@@ -0,0 +1,157 @@
+#include "FrameChain.h"
+
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+
+using namespace std;
+
+namespace ale {
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // FrameRotation Class
+  ///////////////////////////////////////////////////////////////////////////////
+
+  FrameRotation::FrameRotation(const Rotation& rotation) :
+        m_constant(rotation) { }
+
+
+  FrameRotation::FrameRotation(const TimeDependentRotation& rotation) :
+        m_timeDependent(new TimeDependentRotation(rotation)) { }
+
+
+  FrameRotation FrameRotation::inverse() const {
+    if (isTimeDependent()) {
+      return FrameRotation(m_timeDependent->inverse());
+    }
+    return FrameRotation(m_constant.inverse());
+  }
+
+
+  FrameRotation FrameRotation::operator*(const FrameRotation& rightRotation) const {
+    if (isTimeDependent()) {
+      if (rightRotation.isTimeDependent()) {
+        return FrameRotation(*m_timeDependent * *rightRotation.m_timeDependent);
+      }
+      return FrameRotation(*m_timeDependent * rightRotation.m_constant);
+    }
+    if (rightRotation.isTimeDependent()) {
+      return FrameRotation(m_constant * *rightRotation.m_timeDependent);
+    }
+    return FrameRotation(m_constant * rightRotation.m_constant);
+  }
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // FrameChain Class
+  ///////////////////////////////////////////////////////////////////////////////
+
+  void FrameChain::addRotation(int source, int destination, const Rotation& rotation) {
+    FrameRotation frameRotation(rotation);
+    addEdge(source, destination, frameRotation);
+    addEdge(destination, source, frameRotation.inverse());
+  }
+
+
+  void FrameChain::addRotation(int source, int destination, const TimeDependentRotation& rotation) {
+    FrameRotation frameRotation(rotation);
+    addEdge(source, destination, frameRotation);
+    addEdge(destination, source, frameRotation.inverse());
+  }
+
+
+  void FrameChain::addEdge(int source, int destination, const FrameRotation& rotation) {
+    // A new rotation can shorten any path, so forget everything that was chained
+    m_rotations.clear();
+
+    vector<Edge> &edges = m_edges[source];
+    for (Edge &edge : edges) {
+      if (edge.destination == destination) {
+        edge.rotation = rotation;
+        return;
+      }
+    }
+    edges.push_back({destination, rotation});
+  }
+
+
+  const FrameRotation& FrameChain::edgeRotation(int source, int destination) const {
+    for (const Edge &edge : m_edges.at(source)) {
+      if (edge.destination == destination) {
+        return edge.rotation;
+      }
+    }
+    throw invalid_argument("No rotation between frames.");
+  }
+
+
+  vector<int> FrameChain::framePath(int source, int destination) const {
+    if (!hasFrame(source) || !hasFrame(destination)) {
+      throw invalid_argument("Frame is not in the frame chain.");
+    }
+
+    // Breadth first search, remembering the frame that each frame was reached from
+    map<int, int> previous;
+    previous[source] = source;
+    deque<int> frontier(1, source);
+    while (!frontier.empty() && !previous.count(destination)) {
+      int frame = frontier.front();
+      frontier.pop_front();
+      for (const Edge &edge : m_edges.at(frame)) {
+        if (!previous.count(edge.destination)) {
+          previous[edge.destination] = frame;
+          frontier.push_back(edge.destination);
+        }
+      }
+    }
+    if (!previous.count(destination)) {
+      throw invalid_argument("No path between frames.");
+    }
+
+    vector<int> path(1, destination);
+    while (path.back() != source) {
+      path.push_back(previous[path.back()]);
+    }
+    reverse(path.begin(), path.end());
+    return path;
+  }
+
+
+  const FrameRotation& FrameChain::rotation(int source, int destination) {
+    pair<int, int> key(source, destination);
+    map<pair<int, int>, FrameRotation>::const_iterator found = m_rotations.find(key);
+    if (found != m_rotations.end()) {
+      return found->second;
+    }
+
+    FrameRotation chained;
+    if (source != destination) {
+      vector<int> path = framePath(source, destination);
+
+      // Multiply runs of constant rotations together before they touch a
+      // time dependent rotation. Nothing is multiplied by the identity.
+      Rotation constant;
+      bool hasConstant = false;
+      bool hasChained = false;
+      for (size_t i = 0; i + 1 < path.size(); i++) {
+        const FrameRotation &step = edgeRotation(path[i], path[i + 1]);
+        if (!step.isTimeDependent()) {
+          constant = step.constantRotation() * constant;
+          hasConstant = true;
+          continue;
+        }
+        if (hasConstant) {
+          chained = hasChained ? FrameRotation(constant) * chained : FrameRotation(constant);
+          constant = Rotation();
+          hasConstant = false;
+          hasChained = true;
+        }
+        chained = hasChained ? step * chained : step;
+        hasChained = true;
+      }
+      if (hasConstant) {
+        chained = hasChained ? FrameRotation(constant) * chained : FrameRotation(constant);
+      }
+    }
+    return m_rotations.insert(make_pair(key, chained)).first->second;
+  }
+}
@@ -0,0 +1,219 @@
+#include "Interpolator.h"
+
+#include "IntervalCursor.h"
+#include "PiecewisePolynomial.h"
+
+#include <stdexcept>
+
+#include <gsl/gsl_interp.h>
+
+using namespace std;
+
+namespace ale {
+
+  // The most points used by a Lagrange interpolation
+  static const size_t maxLagrangePoints = 8;
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // Interpolator Impl class
+  ///////////////////////////////////////////////////////////////////////////////
+
+  // Internal representation of the interpolation as a GSL interpolation object
+  // and accelerator. GSL only keeps pointers to the data it interpolates over,
+  // so the data is either viewed in place or copied into storage owned here.
+  // Interval searches are done with a persistent cursor, which then seeds the
+  // GSL accelerator.
+  class Interpolator::Impl {
+    public:
+      Impl(const DataView& points, const DataView& times, interpolation interp, bool copy) :
+            numPoints(points.size()), interpolator(nullptr), acc(nullptr),
+            isLagrange(false) {
+        if (numPoints < 2) {
+          throw invalid_argument("At least two points must be input to interpolate over.");
+        }
+        if (points.size() != times.size()) {
+          throw invalid_argument("Invalid gsl_interp_type data, must have the same number of points as times.");
+        }
+
+        if (interp == hermite) {
+          throw invalid_argument("Hermite interpolation requires derivatives, use a PiecewisePolynomial.");
+        }
+
+        // convert our interp enum into a GSL one,
+        // should be easy to add non GSL interp methods here later
+        const gsl_interp_type *interp_methods[] = {gsl_interp_linear, gsl_interp_cspline};
+        isLagrange = (interp == lagrange);
+        if (!isLagrange && numPoints < gsl_interp_type_min_size(interp_methods[interp])) {
+          throw invalid_argument("Not enough points for the requested interpolation type.");
+        }
+
+        ya = storeData(points, ownedPoints, copy);
+        xa = storeData(times, ownedTimes, copy);
+
+        if (isLagrange) {
+          return;
+        }
+        acc = gsl_interp_accel_alloc();
+        interpolator = gsl_interp_alloc(interp_methods[interp], numPoints);
+        gsl_interp_init(interpolator, xa, ya, numPoints);
+      }
+
+
+      ~Impl() {
+        gsl_interp_free(interpolator);
+        gsl_interp_accel_free(acc);
+      }
+
+
+      // Get a contiguous pointer to a view's data, copying it into storage
+      // if it has to be.
+      static const double *storeData(const DataView &view, vector<double> &storage, bool copy) {
+        if (view.contiguous() && !copy) {
+          return view.data();
+        }
+        storage.resize(view.size());
+        for (size_t i = 0; i < view.size(); i++) {
+          storage[i] = view[i];
+        }
+        return storage.data();
+      }
+
+
+      // Evaluate at a time within an interval that has already been found
+      double evalInterval(size_t interval, double time, int d) {
+        if (isLagrange) {
+          return evalLagrange(interval, time, d);
+        }
+        // Point the GSL accelerator at the interval so it does not search again
+        acc->cache = interval;
+        switch(d) {
+          case 0:
+            return gsl_interp_eval(interpolator, xa, ya, time, acc);
+          case 1:
+            return gsl_interp_eval_deriv(interpolator, xa, ya, time, acc);
+          default:
+            return gsl_interp_eval_deriv2(interpolator, xa, ya, time, acc);
+        }
+      }
+
+
+      // Evaluate the Lagrange polynomial through the window of points around
+      // an interval, with the same weights as PiecewisePolynomial.
+      double evalLagrange(size_t interval, double time, int d) {
+        double weights[maxLagrangePoints];
+        double derivativeWeights[maxLagrangePoints];
+        double secondDerivativeWeights[maxLagrangePoints];
+        size_t first;
+        size_t count = PiecewisePolynomial::lagrangeWeights(
+              DataView(xa, numPoints), interval, time, first, weights,
+              (d == 1) ? derivativeWeights : nullptr, (d == 2) ? secondDerivativeWeights : nullptr);
+        const double *basis = (d == 0) ? weights : (d == 1) ? derivativeWeights : secondDerivativeWeights;
+
+        double result = 0.0;
+        for (size_t i = 0; i < count; i++) {
+          result += basis[i] * ya[first + i];
+        }
+        return result;
+      }
+
+
+      size_t numPoints;
+      vector<double> ownedPoints;
+      vector<double> ownedTimes;
+      const double *xa;
+      const double *ya;
+      gsl_interp *interpolator;
+      gsl_interp_accel *acc;
+      IntervalCursor cursor;
+      bool isLagrange;
+  };
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // Interpolator Class
+  ///////////////////////////////////////////////////////////////////////////////
+
+  Interpolator::Interpolator(const vector<double>& points,
+                             const vector<double>& times,
+                             interpolation interp) :
+        m_impl(new Impl(points, times, interp, true)) { }
+
+
+  Interpolator::Interpolator(const DataView& points,
+                             const DataView& times,
+                             interpolation interp) :
+        m_impl(new Impl(points, times, interp, false)) { }
+
+
+  Interpolator::~Interpolator() = default;
+
+
+  Interpolator::Interpolator(Interpolator && other) noexcept = default;
+
+
+  Interpolator& Interpolator::operator=(Interpolator && other) noexcept = default;
+
+
+  double Interpolator::eval(double time, int d) {
+    const double *xa = m_impl->xa;
+    size_t numPoints = m_impl->numPoints;
+    if (time < xa[0] || time > xa[numPoints - 1]) {
+      throw invalid_argument("Invalid gsl_interp_type time, outside of input times.");
+    }
+    if (d < 0 || d > 2) {
+      throw invalid_argument("Invalid derivitive option, must be 0, 1 or 2.");
+    }
+
+    return m_impl->evalInterval(m_impl->cursor.find(xa, numPoints, time), time, d);
+  }
+
+
+  void Interpolator::eval(const double *times, size_t numTimes, int d, double *values) {
+    if (d < 0 || d > 2) {
+      throw invalid_argument("Invalid derivitive option, must be 0, 1 or 2.");
+    }
+    const double *xa = m_impl->xa;
+    size_t numPoints = m_impl->numPoints;
+    double minTime = xa[0];
+    double maxTime = xa[numPoints - 1];
+    for (size_t i = 0; i < numTimes; i++) {
+      if (times[i] < minTime || times[i] > maxTime) {
+        throw invalid_argument("Invalid gsl_interp_type time, outside of input times.");
+      }
+    }
+
+    for (size_t i = 0; i < numTimes; i++) {
+      values[i] = m_impl->evalInterval(m_impl->cursor.find(xa, numPoints, times[i]), times[i], d);
+    }
+  }
+
+
+  void Interpolator::sweep(const double *times, size_t numTimes, int d, double *values) {
+    if (d < 0 || d > 2) {
+      throw invalid_argument("Invalid derivitive option, must be 0, 1 or 2.");
+    }
+    if (numTimes == 0) {
+      return;
+    }
+    const double *xa = m_impl->xa;
+    size_t numPoints = m_impl->numPoints;
+    if (times[0] < xa[0] || times[numTimes - 1] > xa[numPoints - 1]) {
+      throw invalid_argument("Invalid gsl_interp_type time, outside of input times.");
+    }
+    for (size_t i = 1; i < numTimes; i++) {
+      if (times[i] < times[i - 1]) {
+        throw invalid_argument("Invalid sweep times, must be sorted in ascending order.");
+      }
+    }
+
+    IntervalCursor &cursor = m_impl->cursor;
+    cursor.reset();
+    for (size_t i = 0; i < numTimes; i++) {
+      values[i] = m_impl->evalInterval(cursor.advance(xa, numPoints, times[i]), times[i], d);
+    }
+  }
+
+
+  size_t Interpolator::size() const {
+    return m_impl->numPoints;
+  }
+}
@@ -0,0 +1,528 @@
+#include "PiecewisePolynomial.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace ale {
+
+  // The most samples used by a Lagrange interpolation
+  static const size_t maxLagrangeSamples = 8;
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // Coefficient builders
+  ///////////////////////////////////////////////////////////////////////////////
+
+  // Each builder fills in the coefficients for every channel of every
+  // interval, lowest order first. Times is either a DataView or a
+  // UniformTimeGrid.
+
+  static void checkSamples(size_t numTimes, const MatrixView& values) {
+    if (values.numSamples() != numTimes) {
+      throw invalid_argument("Invalid interpolation data, must have the same number of points as times.");
+    }
+  }
+
+
+  template <typename Times>
+  static void linearCoefficients(const Times& times, const MatrixView& values, double *coeffs) {
+    checkSamples(times.size(), values);
+    for (size_t i = 0; i + 1 < times.size(); i++) {
+      double h = times[i + 1] - times[i];
+      for (size_t c = 0; c < values.numComponents(); c++, coeffs += 2) {
+        coeffs[0] = values(c, i);
+        coeffs[1] = (values(c, i + 1) - values(c, i)) / h;
+      }
+    }
+  }
+
+
+  template <typename Times>
+  static void splineCoefficients(const Times& times, const MatrixView& values, double *coeffs) {
+    checkSamples(times.size(), values);
+    size_t n = times.size();
+    if (n < 3) {
+      throw invalid_argument("Not enough points for the requested interpolation type.");
+    }
+
+    // The second derivatives at the interior points solve a tridiagonal
+    // system that only depends on the times, so eliminate it once and then
+    // substitute each channel into it.
+    vector<double> h(n - 1);
+    for (size_t i = 0; i + 1 < n; i++) {
+      h[i] = times[i + 1] - times[i];
+    }
+    vector<double> pivot(n - 1);
+    vector<double> upper(n - 1);
+    for (size_t i = 1; i + 1 < n; i++) {
+      double diag = 2 * (h[i - 1] + h[i]);
+      pivot[i] = (i == 1) ? diag : diag - h[i - 1] * upper[i - 1];
+      upper[i] = h[i] / pivot[i];
+    }
+
+    vector<double> second(n);
+    vector<double> rhs(n - 1);
+    for (size_t c = 0; c < values.numComponents(); c++) {
+      for (size_t i = 1; i + 1 < n; i++) {
+        double r = 6 * ((values(c, i + 1) - values(c, i)) / h[i] -
+                        (values(c, i) - values(c, i - 1)) / h[i - 1]);
+        rhs[i] = (i == 1) ? r / pivot[i] : (r - h[i - 1] * rhs[i - 1]) / pivot[i];
+      }
+      second[0] = 0;
+      second[n - 1] = 0;
+      for (size_t i = n - 2; i >= 1; i--) {
+        second[i] = rhs[i] - upper[i] * second[i + 1];
+      }
+
+      for (size_t i = 0; i + 1 < n; i++) {
+        double *interval = coeffs + 4 * (i * values.numComponents() + c);
+        interval[0] = values(c, i);
+        interval[1] = (values(c, i + 1) - values(c, i)) / h[i] -
+                      h[i] * (2 * second[i] + second[i + 1]) / 6;
+        interval[2] = second[i] / 2;
+        interval[3] = (second[i + 1] - second[i]) / (6 * h[i]);
+      }
+    }
+  }
+
+
+  template <typename Times>
+  static void hermiteCoefficients(const Times& times, const MatrixView& values,
+                                  const MatrixView& derivatives, double *coeffs) {
+    if (values.numComponents() != derivatives.numComponents()) {
+      throw invalid_argument("Invalid hermite data, must have a derivative for each value.");
+    }
+    checkSamples(times.size(), values);
+    checkSamples(times.size(), derivatives);
+    for (size_t i = 0; i + 1 < times.size(); i++) {
+      double h = times[i + 1] - times[i];
+      for (size_t c = 0; c < values.numComponents(); c++, coeffs += 4) {
+        double slope = (values(c, i + 1) - values(c, i)) / h;
+        double d0 = derivatives(c, i);
+        double d1 = derivatives(c, i + 1);
+        coeffs[0] = values(c, i);
+        coeffs[1] = d0;
+        coeffs[2] = (3 * slope - 2 * d0 - d1) / h;
+        coeffs[3] = (d0 + d1 - 2 * slope) / (h * h);
+      }
+    }
+  }
+
+
+  // Lagrange interpolation is evaluated straight from the samples, so the
+  // samples are stored in place of coefficients, every channel of a sample
+  // next to each other.
+  static void lagrangeSamples(size_t numTimes, const MatrixView& values, double *samples) {
+    checkSamples(numTimes, values);
+    for (size_t i = 0; i < numTimes; i++) {
+      for (size_t c = 0; c < values.numComponents(); c++) {
+        *samples++ = values(c, i);
+      }
+    }
+  }
+
+
+  // The Lagrange basis through a set of nodes at x, and its first two
+  // derivatives. Either derivative can be null.
+  static void lagrangeBasis(const double *nodes, size_t count, double x, double *weights,
+                            double *derivativeWeights, double *secondDerivativeWeights) {
+    for (size_t i = 0; i < count; i++) {
+      double p = 1;
+      double dp = 0;
+      double d2p = 0;
+      double denominator = 1;
+      for (size_t j = 0; j < count; j++) {
+        if (j != i) {
+          double difference = x - nodes[j];
+          d2p = d2p * difference + 2 * dp;
+          dp = dp * difference + p;
+          p *= difference;
+          denominator *= nodes[i] - nodes[j];
+        }
+      }
+      weights[i] = p / denominator;
+      if (derivativeWeights) {
+        derivativeWeights[i] = dp / denominator;
+      }
+      if (secondDerivativeWeights) {
+        secondDerivativeWeights[i] = d2p / denominator;
+      }
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // PiecewisePolynomial Class
+  ///////////////////////////////////////////////////////////////////////////////
+
+  PiecewisePolynomial::PiecewisePolynomial(const DataView& times, size_t numChannels, size_t order) :
+        m_uniform(false), m_numChannels(numChannels), m_order(order),
+        m_lagrange(false), m_extrapolation(noExtrapolation) {
+    if (times.size() < 2) {
+      throw invalid_argument("At least two points must be input to interpolate over.");
+    }
+    m_times.resize(times.size());
+    for (size_t i = 0; i < times.size(); i++) {
+      m_times[i] = times[i];
+      if (i > 0 && m_times[i] <= m_times[i - 1]) {
+        throw invalid_argument("Invalid interpolation times, must be strictly increasing.");
+      }
+    }
+    m_coeffs.resize(order * (times.size() - 1) * numChannels);
+  }
+
+
+  PiecewisePolynomial::PiecewisePolynomial(const UniformTimeGrid& times, size_t numChannels, size_t order) :
+        m_grid(times), m_uniform(true), m_numChannels(numChannels), m_order(order),
+        m_lagrange(false), m_extrapolation(noExtrapolation) {
+    if (times.size() < 2) {
+      throw invalid_argument("At least two points must be input to interpolate over.");
+    }
+    m_coeffs.resize(order * (times.size() - 1) * numChannels);
+  }
+
+
+  PiecewisePolynomial PiecewisePolynomial::linear(const DataView& times, const MatrixView& values) {
+    PiecewisePolynomial poly(times, values.numComponents(), 2);
+    linearCoefficients(times, values, poly.m_coeffs.data());
+    return poly;
+  }
+
+
+  PiecewisePolynomial PiecewisePolynomial::linear(const UniformTimeGrid& times, const MatrixView& values) {
+    PiecewisePolynomial poly(times, values.numComponents(), 2);
+    linearCoefficients(times, values, poly.m_coeffs.data());
+    return poly;
+  }
+
+
+  PiecewisePolynomial PiecewisePolynomial::spline(const DataView& times, const MatrixView& values) {
+    PiecewisePolynomial poly(times, values.numComponents(), 4);
+    splineCoefficients(times, values, poly.m_coeffs.data());
+    return poly;
+  }
+
+
+  PiecewisePolynomial PiecewisePolynomial::spline(const UniformTimeGrid& times, const MatrixView& values) {
+    PiecewisePolynomial poly(times, values.numComponents(), 4);
+    splineCoefficients(times, values, poly.m_coeffs.data());
+    return poly;
+  }
+
+
+  PiecewisePolynomial PiecewisePolynomial::hermite(const DataView& times,
+                                                   const MatrixView& values,
+                                                   const MatrixView& derivatives) {
+    PiecewisePolynomial poly(times, values.numComponents(), 4);
+    hermiteCoefficients(times, values, derivatives, poly.m_coeffs.data());
+    return poly;
+  }
+
+
+  PiecewisePolynomial PiecewisePolynomial::hermite(const UniformTimeGrid& times,
+                                                   const MatrixView& values,
+                                                   const MatrixView& derivatives) {
+    PiecewisePolynomial poly(times, values.numComponents(), 4);
+    hermiteCoefficients(times, values, derivatives, poly.m_coeffs.data());
+    return poly;
+  }
+
+
+  PiecewisePolynomial PiecewisePolynomial::lagrange(const DataView& times, const MatrixView& values) {
+    PiecewisePolynomial poly(times, values.numComponents(), maxLagrangeSamples);
+    poly.m_lagrange = true;
+    poly.m_coeffs.resize(times.size() * values.numComponents());
+    lagrangeSamples(times.size(), values, poly.m_coeffs.data());
+    return poly;
+  }
+
+
+  PiecewisePolynomial PiecewisePolynomial::lagrange(const UniformTimeGrid& times, const MatrixView& values) {
+    PiecewisePolynomial poly(times, values.numComponents(), maxLagrangeSamples);
+    poly.m_lagrange = true;
+    poly.m_coeffs.resize(times.size() * values.numComponents());
+    lagrangeSamples(times.size(), values, poly.m_coeffs.data());
+    return poly;
+  }
+
+
+  // Build the polynomials for an interpolation type
+  template <typename Times>
+  static PiecewisePolynomial interpolatingPolynomial(const Times& times, const MatrixView& values,
+                                                     interpolation interp) {
+    switch (interp) {
+      case linear:
+        return PiecewisePolynomial::linear(times, values);
+      case spline:
+        return PiecewisePolynomial::spline(times, values);
+      case lagrange:
+        return PiecewisePolynomial::lagrange(times, values);
+      default:
+        throw invalid_argument("Hermite interpolation requires derivatives, use a PiecewisePolynomial.");
+    }
+  }
+
+
+  PiecewisePolynomial PiecewisePolynomial::fromInterpolation(const DataView& times,
+                                                             const MatrixView& values,
+                                                             interpolation interp) {
+    return interpolatingPolynomial(times, values, interp);
+  }
+
+
+  PiecewisePolynomial PiecewisePolynomial::fromInterpolation(const UniformTimeGrid& times,
+                                                             const MatrixView& values,
+                                                             interpolation interp) {
+    return interpolatingPolynomial(times, values, interp);
+  }
+
+
+  void PiecewisePolynomial::lagrangeWindow(size_t interval, size_t numSamples,
+                                           size_t &first, size_t &count) {
+    size_t fromEnd = min(interval, numSamples - 2 - interval);
+    count = min(2 * (fromEnd + 1), maxLagrangeSamples);
+    first = interval + 1 - count / 2;
+  }
+
+
+  size_t PiecewisePolynomial::lagrangeWeights(const UniformTimeGrid& times, double time, size_t &first,
+                                              double *weights, double *derivativeWeights,
+                                              double *secondDerivativeWeights) {
+    // This is usgscsm's lagrangeInterp step for step, so that the values are
+    // the same as the sensor model's down to the last bit
+    double fndex = (time - times.start()) / times.step();
+    size_t index = times.interval(time);
+    size_t count;
+    lagrangeWindow(index, times.size(), first, count);
+
+    double t = fndex - index;
+    double tp3, tp2, tp1, tm1, tm2, tm3, tm4;
+    switch (count) {
+      case 2:
+        tm1 = t - 1;
+        weights[0] = -tm1;
+        weights[1] = t;
+        break;
+      case 4:
+        tp1 = t + 1;
+        tm1 = t - 1;
+        tm2 = t - 2;
+        weights[0] = -t * tm1 * tm2 / 6.0;
+        weights[1] = tp1 * tm1 * tm2 / 2.0;
+        weights[2] = -tp1 * t * tm2 / 2.0;
+        weights[3] = tp1 * t * tm1 / 6.0;
+        break;
+      case 6:
+        tp2 = t + 2;
+        tp1 = t + 1;
+        tm1 = t - 1;
+        tm2 = t - 2;
+        tm3 = t - 3;
+        weights[0] = -tp1 * t * tm1 * tm2 * tm3 / 120.0;
+        weights[1] = tp2 * t * tm1 * tm2 * tm3 / 24.0;
+        weights[2] = -tp2 * tp1 * tm1 * tm2 * tm3 / 12.0;
+        weights[3] = tp2 * tp1 * t * tm2 * tm3 / 12.0;
+        weights[4] = -tp2 * tp1 * t * tm1 * tm3 / 24.0;
+        weights[5] = tp2 * tp1 * t * tm1 * tm2 / 120.0;
+        break;
+      default:
+        tp3 = t + 3;
+        tp2 = t + 2;
+        tp1 = t + 1;
+        tm1 = t - 1;
+        tm2 = t - 2;
+        tm3 = t - 3;
+        tm4 = t - 4;
+        weights[0] = -tp2 * tp1 * t * tm1 * tm2 * tm3 * tm4 / 5040.0;
+        weights[1] = tp3 * tp1 * t * tm1 * tm2 * tm3 * tm4 / 720.0;
+        weights[2] = -tp3 * tp2 * t * tm1 * tm2 * tm3 * tm4 / 240.0;
+        weights[3] = tp3 * tp2 * tp1 * tm1 * tm2 * tm3 * tm4 / 144.0;
+        weights[4] = -tp3 * tp2 * tp1 * t * tm2 * tm3 * tm4 / 144.0;
+        weights[5] = tp3 * tp2 * tp1 * t * tm1 * tm3 * tm4 / 240.0;
+        weights[6] = -tp3 * tp2 * tp1 * t * tm1 * tm2 * tm4 / 720.0;
+        weights[7] = tp3 * tp2 * tp1 * t * tm1 * tm2 * tm3 / 5040.0;
+        break;
+    }
+
+    // lagrangeInterp has no derivatives, so they come from the same basis in
+    // steps from the start of the interval
+    if (derivativeWeights || secondDerivativeWeights) {
+      double nodes[maxLagrangeSamples] = {};
+      double unused[maxLagrangeSamples];
+      for (size_t j = 0; j < count; j++) {
+        nodes[j] = static_cast<double>(first + j) - static_cast<double>(index);
+      }
+      lagrangeBasis(nodes, count, t, unused, derivativeWeights, secondDerivativeWeights);
+      double step = times.step();
+      for (size_t j = 0; j < count; j++) {
+        if (derivativeWeights) {
+          derivativeWeights[j] /= step;
+        }
+        if (secondDerivativeWeights) {
+          secondDerivativeWeights[j] /= step * step;
+        }
+      }
+    }
+    return count;
+  }
+
+
+  size_t PiecewisePolynomial::lagrangeWeights(const DataView& times, size_t interval, double time,
+                                              size_t &first, double *weights, double *derivativeWeights,
+                                              double *secondDerivativeWeights) {
+    size_t count;
+    lagrangeWindow(interval, times.size(), first, count);
+    double nodes[maxLagrangeSamples];
+    for (size_t j = 0; j < count; j++) {
+      nodes[j] = times[first + j];
+    }
+    lagrangeBasis(nodes, count, time, weights, derivativeWeights, secondDerivativeWeights);
+    return count;
+  }
+
+
+  void PiecewisePolynomial::evaluate(double time, double *values, double *derivatives) {
+    evaluateInterval(findInterval(time), time, values, derivatives);
+  }
+
+
+  void PiecewisePolynomial::evaluate(const double *times, size_t numTimes,
+                                     double *values, double *derivatives) {
+    for (size_t i = 0; i < numTimes; i++) {
+      evaluateInterval(findInterval(times[i]), times[i],
+                       values ? values + i * m_numChannels : nullptr,
+                       derivatives ? derivatives + i * m_numChannels : nullptr);
+    }
+  }
+
+
+  void PiecewisePolynomial::sweep(const double *times, size_t numTimes,
+                                  double *values, double *derivatives) {
+    if (numTimes == 0) {
+      return;
+    }
+    if (times[0] < time(0) || times[numTimes - 1] > time(size() - 1)) {
+      throw invalid_argument("Invalid interpolation time, outside of input times.");
+    }
+    for (size_t i = 1; i < numTimes; i++) {
+      if (times[i] < times[i - 1]) {
+        throw invalid_argument("Invalid sweep times, must be sorted in ascending order.");
+      }
+    }
+
+    m_cursor.reset();
+    for (size_t i = 0; i < numTimes; i++) {
+      size_t interval = m_uniform ? m_grid.interval(times[i])
+                                  : m_cursor.advance(m_times.data(), m_times.size(), times[i]);
+      evaluateInterval(interval, times[i],
+                       values ? values + i * m_numChannels : nullptr,
+                       derivatives ? derivatives + i * m_numChannels : nullptr);
+    }
+  }
+
+
+  evaluationStatus PiecewisePolynomial::tryEvaluate(double time, double *values,
+                                                    double *derivatives) noexcept {
+    double first = this->time(0);
+    double last = this->time(size() - 1);
+    if (time >= first && time <= last) {
+      evaluateInterval(locateInterval(time), time, values, derivatives);
+      return evaluated;
+    }
+    // NaN fails both comparisons
+    if (!(time < first || time > last)) {
+      return outOfRange;
+    }
+
+    size_t interval = time < first ? 0 : size() - 2;
+    switch (m_extrapolation) {
+      case clampToEnds:
+        evaluateInterval(interval, time < first ? first : last, values, nullptr);
+        if (derivatives) {
+          fill(derivatives, derivatives + m_numChannels, 0.0);
+        }
+        return clamped;
+      case extrapolateEnds:
+        evaluateInterval(interval, time, values, derivatives);
+        return extrapolated;
+      default:
+        return outOfRange;
+    }
+  }
+
+
+  evaluationStatus PiecewisePolynomial::tryEvaluate(const double *times, size_t numTimes,
+                                                    double *values, double *derivatives) noexcept {
+    evaluationStatus worst = evaluated;
+    for (size_t i = 0; i < numTimes; i++) {
+      evaluationStatus status = tryEvaluate(times[i], values ? values + i * m_numChannels : nullptr,
+                                            derivatives ? derivatives + i * m_numChannels : nullptr);
+      worst = max(worst, status);
+    }
+    return worst;
+  }
+
+
+  size_t PiecewisePolynomial::findInterval(double time) {
+    if (!(time >= this->time(0) && time <= this->time(size() - 1))) {
+      throw invalid_argument("Invalid interpolation time, outside of input times.");
+    }
+    return locateInterval(time);
+  }
+
+
+  void PiecewisePolynomial::evaluateInterval(size_t interval, double time,
+                                             double *values, double *derivatives) const {
+    if (m_lagrange) {
+      evaluateLagrange(interval, time, values, derivatives);
+      return;
+    }
+    double s = time - this->time(interval);
+    const double *coeffs = m_coeffs.data() + m_order * interval * m_numChannels;
+    for (size_t c = 0; c < m_numChannels; c++, coeffs += m_order) {
+      // Horner's method for the value and first derivative together
+      double value = coeffs[m_order - 1];
+      double derivative = 0;
+      for (size_t k = m_order - 1; k-- > 0;) {
+        derivative = derivative * s + value;
+        value = value * s + coeffs[k];
+      }
+      if (values) {
+        values[c] = value;
+      }
+      if (derivatives) {
+        derivatives[c] = derivative;
+      }
+    }
+  }
+
+
+  void PiecewisePolynomial::evaluateLagrange(size_t interval, double time,
+                                             double *values, double *derivatives) const {
+    double weights[maxLagrangeSamples];
+    double derivativeWeights[maxLagrangeSamples];
+    double *dWeights = derivatives ? derivativeWeights : nullptr;
+    size_t first;
+    size_t count = m_uniform ? lagrangeWeights(m_grid, time, first, weights, dWeights)
+                             : lagrangeWeights(DataView(m_times), interval, time, first, weights, dWeights);
+
+    // Accumulate from zero in window order, like lagrangeInterp
+    const double *samples = m_coeffs.data() + first * m_numChannels;
+    for (size_t c = 0; c < m_numChannels; c++) {
+      if (values) {
+        double value = 0.0;
+        for (size_t i = 0; i < count; i++) {
+          value += weights[i] * samples[i * m_numChannels + c];
+        }
+        values[c] = value;
+      }
+      if (derivatives) {
+        double derivative = 0.0;
+        for (size_t i = 0; i < count; i++) {
+          derivative += derivativeWeights[i] * samples[i * m_numChannels + c];
+        }
+        derivatives[c] = derivative;
+      }
+    }
+  }
+}
@@ -0,0 +1,141 @@
+#include "Polynomial.h"
+
+#include <stdexcept>
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace ale {
+
+  // Evaluate a polynomial and its first two derivatives at a single time
+  static inline void hornerScalar(const double *coeffs, size_t numCoeffs, double time,
+                                  double &value, double &first, double &second) {
+    double p = coeffs[numCoeffs - 1];
+    double d1 = 0;
+    double d2 = 0;
+    for (size_t k = numCoeffs - 1; k-- > 0;) {
+      d2 = d2 * time + d1;
+      d1 = d1 * time + p;
+      p = p * time + coeffs[k];
+    }
+    value = p;
+    first = d1;
+    second = 2 * d2;
+  }
+
+
+  // Table of the unrolled kernels, indexed by degree and then derivative
+  typedef double (*PolynomialKernel)(const double *, double);
+
+#define ALE_POLYNOMIAL_KERNELS(N) \
+  {evaluatePolynomial<N, 0>, evaluatePolynomial<N, 1>, evaluatePolynomial<N, 2>}
+
+  static const PolynomialKernel polynomialKernels[maxUnrolledDegree + 1][3] = {
+    ALE_POLYNOMIAL_KERNELS(0), ALE_POLYNOMIAL_KERNELS(1), ALE_POLYNOMIAL_KERNELS(2),
+    ALE_POLYNOMIAL_KERNELS(3), ALE_POLYNOMIAL_KERNELS(4), ALE_POLYNOMIAL_KERNELS(5),
+    ALE_POLYNOMIAL_KERNELS(6), ALE_POLYNOMIAL_KERNELS(7), ALE_POLYNOMIAL_KERNELS(8),
+    ALE_POLYNOMIAL_KERNELS(9), ALE_POLYNOMIAL_KERNELS(10)
+  };
+
+#undef ALE_POLYNOMIAL_KERNELS
+
+
+  double evaluatePolynomial(const double *coeffs, size_t numCoeffs, double time, int d) {
+    if (numCoeffs == 0) {
+      throw invalid_argument("Invalid input coeffs, must be non-empty.");
+    }
+    if (d < 0) {
+      throw invalid_argument("Invalid derivative degree, must be non-negative.");
+    }
+
+    size_t degree = numCoeffs - 1;
+    if (degree <= static_cast<size_t>(maxUnrolledDegree) && d <= 2) {
+      return polynomialKernels[degree][d](coeffs, time);
+    }
+
+    double result = 0;
+    for (size_t k = numCoeffs; k-- > static_cast<size_t>(d);) {
+      result = result * time + coeffs[k] * detail::fallingFactorial(k, d);
+    }
+    return result;
+  }
+
+
+  void evaluatePolynomial(const double *coeffs, size_t numCoeffs,
+                          const double *times, size_t numTimes,
+                          double *values,
+                          double *firstDerivatives,
+                          double *secondDerivatives) {
+    if (numCoeffs == 0) {
+      throw invalid_argument("Invalid input coeffs, must be non-empty.");
+    }
+
+    size_t i = 0;
+
+#if defined(__AVX512F__)
+    const size_t width = 8;
+    const __m512d two = _mm512_set1_pd(2.0);
+    for (; i + width <= numTimes; i += width) {
+      __m512d t = _mm512_loadu_pd(times + i);
+      __m512d p = _mm512_set1_pd(coeffs[numCoeffs - 1]);
+      __m512d d1 = _mm512_setzero_pd();
+      __m512d d2 = _mm512_setzero_pd();
+      for (size_t k = numCoeffs - 1; k-- > 0;) {
+        d2 = _mm512_fmadd_pd(d2, t, d1);
+        d1 = _mm512_fmadd_pd(d1, t, p);
+        p = _mm512_fmadd_pd(p, t, _mm512_set1_pd(coeffs[k]));
+      }
+      if (values) {
+        _mm512_storeu_pd(values + i, p);
+      }
+      if (firstDerivatives) {
+        _mm512_storeu_pd(firstDerivatives + i, d1);
+      }
+      if (secondDerivatives) {
+        _mm512_storeu_pd(secondDerivatives + i, _mm512_mul_pd(two, d2));
+      }
+    }
+#elif defined(__AVX2__) && defined(__FMA__)
+    const size_t width = 4;
+    const __m256d two = _mm256_set1_pd(2.0);
+    for (; i + width <= numTimes; i += width) {
+      __m256d t = _mm256_loadu_pd(times + i);
+      __m256d p = _mm256_set1_pd(coeffs[numCoeffs - 1]);
+      __m256d d1 = _mm256_setzero_pd();
+      __m256d d2 = _mm256_setzero_pd();
+      for (size_t k = numCoeffs - 1; k-- > 0;) {
+        d2 = _mm256_fmadd_pd(d2, t, d1);
+        d1 = _mm256_fmadd_pd(d1, t, p);
+        p = _mm256_fmadd_pd(p, t, _mm256_set1_pd(coeffs[k]));
+      }
+      if (values) {
+        _mm256_storeu_pd(values + i, p);
+      }
+      if (firstDerivatives) {
+        _mm256_storeu_pd(firstDerivatives + i, d1);
+      }
+      if (secondDerivatives) {
+        _mm256_storeu_pd(secondDerivatives + i, _mm256_mul_pd(two, d2));
+      }
+    }
+#endif
+
+    // Scalar loop for the remaining times
+    for (; i < numTimes; i++) {
+      double value, first, second;
+      hornerScalar(coeffs, numCoeffs, times[i], value, first, second);
+      if (values) {
+        values[i] = value;
+      }
+      if (firstDerivatives) {
+        firstDerivatives[i] = first;
+      }
+      if (secondDerivatives) {
+        secondDerivatives[i] = second;
+      }
+    }
+  }
+}
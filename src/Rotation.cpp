@@ -1,10 +1,16 @@
 #include "Rotation.h"
 
 #include <algorithm>
+#include <cmath>
 #include <exception>
+#include <stdexcept>
+#include <vector>
 
 #include <Eigen/Geometry>
 
+#include "PiecewisePolynomial.h"
+#include "RotationInterpolator.h"
+
 namespace ale {
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -43,163 +49,232 @@ namespace ale {
    * as the AV from the destination to the source. This matches how NAIF
    * defines AV.
    */
+  Eigen::Quaterniond::Matrix3 avSkewMatrix(const double *av) {
+    Eigen::Quaterniond::Matrix3 avMat;
+    avMat <<  0.0,    av[2], -av[1],
+             -av[2],  0.0,    av[0],
+              av[1], -av[0],  0.0;
+    return avMat;
+  }
+
+
   Eigen::Quaterniond::Matrix3 avSkewMatrix(
         const std::vector<double>& av
   ) {
     if (av.size() != 3) {
       throw std::invalid_argument("Angular velocity vector to rotate is the wrong size.");
     }
-    Eigen::Quaterniond::Matrix3 avMat;
-    avMat <<  0.0,    av[2], -av[1],
-             -av[2],  0.0,    av[0],
-              av[1], -av[0],  0.0;
-    return avMat;
+    return avSkewMatrix(av.data());
   }
 
-  ///////////////////////////////////////////////////////////////////////////////
-  // Rotation Impl class
-  ///////////////////////////////////////////////////////////////////////////////
+  // The number of series terms in fastSlerp
+  static const int fastSlerpTerms = 6;
 
-  // Internal representation of the rotation as an Eigen Double Quaternion
-  class Rotation::Impl {
-    public:
-      Impl() : quat(Eigen::Quaterniond::Identity()) { }
+  /**
+   * The slerp weights sin((1 - t)a) / sin(a) and sin(ta) / sin(a) from the
+   * first terms of their series in cos(a) - 1, after Eberly's "A Fast and
+   * Accurate Algorithm for Computing SLERP". The series converges quickly
+   * for small angles and needs no trigonometry.
+   */
+  static void fastSlerpWeights(double cosAngle, double t, double &weight0, double &weight1) {
+    double x = cosAngle - 1;
+    double term0 = 1 - t;
+    double term1 = t;
+    weight0 = term0;
+    weight1 = term1;
+    for (int i = 1; i < fastSlerpTerms; i++) {
+      double scale = x / (i * (2.0 * i + 1));
+      term0 *= ((1 - t) * (1 - t) - i * i) * scale;
+      term1 *= (t * t - i * i) * scale;
+      weight0 += term0;
+      weight1 += term1;
+    }
+  }
 
 
-      Impl(double w, double x, double y, double z) : quat(w, x, y, z) { }
+  // Approximate slerp along the shorter path, like Eigen's slerp
+  static Eigen::Quaterniond fastSlerpQuaternion(const Eigen::Quaterniond &quat,
+                                                const Eigen::Quaterniond &nextQuat,
+                                                double dot, double t) {
+    double weight0, weight1;
+    fastSlerpWeights(std::abs(dot), t, weight0, weight1);
+    if (dot < 0) {
+      weight1 = -weight1;
+    }
+    Eigen::Quaterniond interpQuat;
+    interpQuat.coeffs() = weight0 * quat.coeffs() + weight1 * nextQuat.coeffs();
+    return interpQuat.normalized();
+  }
 
+  // Quaternions are stored w, x, y, z, but Eigen stores them x, y, z, w
+  static Eigen::Quaterniond loadQuaternion(const double *data) {
+    return Eigen::Quaterniond(data[0], data[1], data[2], data[3]);
+  }
 
-      Impl(const std::vector<double>& matrix) {
-        if (matrix.size() != 9) {
-          throw std::invalid_argument("Rotation matrix must be 3 by 3.");
-        }
-        quat = Eigen::Quaterniond(Eigen::Quaterniond::Matrix3(matrix.data()));
-      }
 
+  static void storeQuaternion(const Eigen::Quaterniond &quat, double *data) {
+    data[0] = quat.w();
+    data[1] = quat.x();
+    data[2] = quat.y();
+    data[3] = quat.z();
+  }
 
-      Impl(const std::vector<double>& angles, const std::vector<int>& axes) {
-        if (angles.empty() || axes.empty()) {
-          throw std::invalid_argument("Angles and axes must be non-empty.");
-        }
-        if (angles.size() != axes.size()) {
-          throw std::invalid_argument("Number of angles and axes must be equal.");
-        }
-        quat = Eigen::Quaterniond::Identity();
 
-        for (size_t i = 0; i < angles.size(); i++) {
-          quat *= Eigen::Quaterniond(Eigen::AngleAxisd(angles[i], axis(axes[i])));
-        }
-      }
+  static void storeVector(const Eigen::Vector3d &vec, double *data) {
+    data[0] = vec.x();
+    data[1] = vec.y();
+    data[2] = vec.z();
+  }
 
 
-      Impl(const std::vector<double>& axis, double theta) {
-        if (axis.size() != 3) {
-          throw std::invalid_argument("Rotation axis must have 3 elements.");
-        }
-        Eigen::Vector3d eigenAxis((double *) axis.data());
-        quat = Eigen::Quaterniond(Eigen::AngleAxisd(theta, eigenAxis.normalized()));
-      }
+  // The rotation about a rotation vector by its length
+  static Eigen::Quaterniond rotationVectorQuaternion(const Eigen::Vector3d &rotationVector) {
+    double angle = rotationVector.norm();
+    if (angle == 0) {
+      return Eigen::Quaterniond::Identity();
+    }
+    return Eigen::Quaterniond(Eigen::AngleAxisd(angle, rotationVector / angle));
+  }
 
+  // The quaternion is stored x, y, z, w, which is Eigen's order, so Eigen
+  // can work on it in place
+  static Eigen::Map<const Eigen::Quaterniond> eigenQuaternion(const double *coeffs) {
+    return Eigen::Map<const Eigen::Quaterniond>(coeffs);
+  }
 
-      Eigen::Quaterniond quat;
-  };
+
+  static void setCoeffs(const Eigen::Quaterniond &quat, double *coeffs) {
+    Eigen::Map<Eigen::Vector4d> stored(coeffs);
+    stored = quat.coeffs();
+  }
 
   ///////////////////////////////////////////////////////////////////////////////
   // Rotation Class
   ///////////////////////////////////////////////////////////////////////////////
 
-  Rotation::Rotation() :
-        m_impl(new Impl()) { }
-
-
-  Rotation::Rotation(double w, double x, double y, double z) :
-        m_impl(new Impl(w, x, y, z)) { }
-
+  Rotation::Rotation() {
+    setCoeffs(Eigen::Quaterniond::Identity(), m_coeffs);
+  }
 
-  Rotation::Rotation(const std::vector<double>& matrix) :
-        m_impl(new Impl(matrix)) { }
 
+  Rotation::Rotation(double w, double x, double y, double z) {
+    setCoeffs(Eigen::Quaterniond(w, x, y, z), m_coeffs);
+  }
 
-  Rotation::Rotation(const std::vector<double>& angles, const std::vector<int>& axes) :
-        m_impl(new Impl(angles, axes)) { }
 
+  Rotation::Rotation(const std::vector<double>& matrix) {
+    if (matrix.size() != 9) {
+      throw std::invalid_argument("Rotation matrix must be 3 by 3.");
+    }
+    setCoeffs(Eigen::Quaterniond(Eigen::Quaterniond::Matrix3(matrix.data())), m_coeffs);
+  }
 
-  Rotation::Rotation(const std::vector<double>& axis, double theta) :
-        m_impl(new Impl(axis, theta)) { }
 
+  Rotation::Rotation(const std::vector<double>& angles, const std::vector<int>& axes) {
+    if (angles.empty() || axes.empty()) {
+      throw std::invalid_argument("Angles and axes must be non-empty.");
+    }
+    if (angles.size() != axes.size()) {
+      throw std::invalid_argument("Number of angles and axes must be equal.");
+    }
+    Eigen::Quaterniond quat = Eigen::Quaterniond::Identity();
 
-  Rotation::~Rotation() = default;
+    for (size_t i = 0; i < angles.size(); i++) {
+      quat *= Eigen::Quaterniond(Eigen::AngleAxisd(angles[i], axis(axes[i])));
+    }
+    setCoeffs(quat, m_coeffs);
+  }
 
 
-  Rotation::Rotation(Rotation && other) noexcept = default;
+  Rotation::Rotation(const std::vector<double>& axis, double theta) {
+    if (axis.size() != 3) {
+      throw std::invalid_argument("Rotation axis must have 3 elements.");
+    }
+    Eigen::Vector3d eigenAxis((double *) axis.data());
+    setCoeffs(Eigen::Quaterniond(Eigen::AngleAxisd(theta, eigenAxis.normalized())), m_coeffs);
+  }
 
 
-  Rotation& Rotation::operator=(Rotation && other) noexcept = default;
+  void Rotation::toQuaternion(double *quaternion) const noexcept {
+    Eigen::Quaterniond normalized = eigenQuaternion(m_coeffs).normalized();
+    quaternion[0] = normalized.w();
+    quaternion[1] = normalized.x();
+    quaternion[2] = normalized.y();
+    quaternion[3] = normalized.z();
+  }
 
 
-  // unique_ptr doesn't have a copy constructor so we have to define one
-  Rotation::Rotation(const Rotation& other) : m_impl(new Impl(*other.m_impl)) { }
+  std::vector<double> Rotation::toQuaternion() const {
+    std::vector<double> quaternion(4);
+    toQuaternion(quaternion.data());
+    return quaternion;
+  }
 
 
-  // unique_ptr doesn't have an assignment operator so we have to define one
-  Rotation& Rotation::operator=(const Rotation& other) {
-    if (this != &other) {
-      m_impl.reset(new Impl(*other.m_impl));
-    }
-    return *this;
+  void Rotation::toRotationMatrix(double *matrix) const noexcept {
+    Eigen::Map<Eigen::Quaterniond::Matrix3> mat(matrix);
+    mat = eigenQuaternion(m_coeffs).toRotationMatrix();
   }
 
 
-  std::vector<double> Rotation::toQuaternion() const {
-    Eigen::Quaterniond normalized = m_impl->quat.normalized();
-    return {normalized.w(), normalized.x(), normalized.y(), normalized.z()};
+  std::vector<double> Rotation::toRotationMatrix() const {
+    std::vector<double> matrix(9);
+    toRotationMatrix(matrix.data());
+    return matrix;
   }
 
 
-  std::vector<double> Rotation::toRotationMatrix() const {
-    Eigen::Quaterniond::RotationMatrixType mat = m_impl->quat.toRotationMatrix();
-    return std::vector<double>(mat.data(), mat.data() + mat.size());
+  void Rotation::toStateRotationMatrix(const double *av, double *matrix) const noexcept {
+    PreparedRotation(*this, av).toStateRotationMatrix(matrix);
   }
 
 
   std::vector<double> Rotation::toStateRotationMatrix(const std::vector<double> &av) const {
-    Eigen::Quaterniond::Matrix3 rotMat = m_impl->quat.toRotationMatrix();
-    Eigen::Quaterniond::Matrix3 avMat = avSkewMatrix(av);
-    Eigen::Quaterniond::Matrix3 dtMat = rotMat * avMat;
-    return {rotMat(0,0), rotMat(0,1), rotMat(0,2), 0.0,         0.0,         0.0,
-            rotMat(1,0), rotMat(1,1), rotMat(1,2), 0.0,         0.0,         0.0,
-            rotMat(2,0), rotMat(2,1), rotMat(2,2), 0.0,         0.0,         0.0,
-            dtMat(0,0),  dtMat(0,1),  dtMat(0,2),  rotMat(0,0), rotMat(0,1), rotMat(0,2),
-            dtMat(1,0),  dtMat(1,1),  dtMat(1,2),  rotMat(1,0), rotMat(1,1), rotMat(1,2),
-            dtMat(2,0),  dtMat(2,1),  dtMat(2,2),  rotMat(2,0), rotMat(2,1), rotMat(2,2)};
+    if (av.size() != 3) {
+      throw std::invalid_argument("Angular velocity vector to rotate is the wrong size.");
+    }
+    std::vector<double> matrix(36);
+    toStateRotationMatrix(av.data(), matrix.data());
+    return matrix;
   }
 
 
-  std::vector<double> Rotation::toEuler(const std::vector<int>& axes) const {
-    if (axes.size() != 3) {
-      throw std::invalid_argument("Must have 3 axes to convert to Euler angles.");
-    }
+  void Rotation::toEuler(const std::array<int, 3>& axes, double *angles) const {
     if (axes[0] < 0 || axes[0] > 2 ||
         axes[1] < 0 || axes[1] > 2 ||
         axes[2] < 0 || axes[2] > 2) {
       throw std::invalid_argument("Invalid axis number.");
     }
-    Eigen::Vector3d angles = m_impl->quat.toRotationMatrix().eulerAngles(
+    Eigen::Map<Eigen::Vector3d> eulerAngles(angles);
+    eulerAngles = eigenQuaternion(m_coeffs).toRotationMatrix().eulerAngles(
           axes[0],
           axes[1],
           axes[2]);
-    return std::vector<double>(angles.data(), angles.data() + angles.size());
+  }
+
+
+  std::vector<double> Rotation::toEuler(const std::vector<int>& axes) const {
+    if (axes.size() != 3) {
+      throw std::invalid_argument("Must have 3 axes to convert to Euler angles.");
+    }
+    std::vector<double> angles(3);
+    toEuler({{axes[0], axes[1], axes[2]}}, angles.data());
+    return angles;
+  }
+
+
+  double Rotation::toAxisAngle(double *axis) const noexcept {
+    Eigen::AngleAxisd eigenAxisAngle(eigenQuaternion(m_coeffs));
+    Eigen::Map<Eigen::Vector3d> axisVector(axis);
+    axisVector = eigenAxisAngle.axis();
+    return eigenAxisAngle.angle();
   }
 
 
   std::pair<std::vector<double>, double> Rotation::toAxisAngle() const {
-    Eigen::AngleAxisd eigenAxisAngle(m_impl->quat);
     std::pair<std::vector<double>, double> axisAngle;
-    axisAngle.first = std::vector<double>(
-          eigenAxisAngle.axis().data(),
-          eigenAxisAngle.axis().data() + eigenAxisAngle.axis().size()
-    );
-    axisAngle.second = eigenAxisAngle.angle();
+    axisAngle.first.resize(3);
+    axisAngle.second = toAxisAngle(axisAngle.first.data());
     return axisAngle;
   }
 
@@ -210,13 +285,13 @@ namespace ale {
   ) const {
     if (vector.size() == 3) {
       Eigen::Map<Eigen::Vector3d> eigenVector((double *)vector.data());
-      Eigen::Vector3d rotatedVector = m_impl->quat._transformVector(eigenVector);
+      Eigen::Vector3d rotatedVector = eigenQuaternion(m_coeffs)._transformVector(eigenVector);
       return std::vector<double>(rotatedVector.data(), rotatedVector.data() + rotatedVector.size());
     }
     else if (vector.size() == 6) {
       Eigen::Map<Eigen::Vector3d> positionVector((double *)vector.data());
       Eigen::Map<Eigen::Vector3d> velocityVector((double *)vector.data() + 3);
-      Eigen::Quaterniond::Matrix3 rotMat = m_impl->quat.toRotationMatrix();
+      Eigen::Quaterniond::Matrix3 rotMat = eigenQuaternion(m_coeffs).toRotationMatrix();
       Eigen::Quaterniond::Matrix3 avMat = avSkewMatrix(av);
       Eigen::Quaterniond::Matrix3 rotationDerivative = rotMat * avMat;
       Eigen::Vector3d rotatedPosition = rotMat * positionVector;
@@ -230,14 +305,60 @@ namespace ale {
   }
 
 
+  void Rotation::apply(const double *vector, double *rotated) const noexcept {
+    // Rotate into a temporary so that the output can alias the input
+    Eigen::Map<const Eigen::Vector3d> eigenVector(vector);
+    Eigen::Vector3d rotatedVector = eigenQuaternion(m_coeffs)._transformVector(eigenVector);
+    Eigen::Map<Eigen::Vector3d> output(rotated);
+    output = rotatedVector;
+  }
+
+
+  void Rotation::apply(const double *vectors, double *rotated, size_t numVectors) const noexcept {
+    PreparedRotation(*this).apply(vectors, rotated, numVectors);
+  }
+
+
+  void Rotation::applyState(
+        const double *states,
+        double *rotated,
+        size_t numStates,
+        const double *av
+  ) const noexcept {
+    PreparedRotation(*this, av).applyState(states, rotated, numStates);
+  }
+
+
+  void Rotation::applyStateSeries(
+        const double *states,
+        const double *angularVelocities,
+        double *rotated,
+        size_t numStates
+  ) const noexcept {
+    // The transposed skew matrix times the position is minus the cross product
+    Eigen::Quaterniond::Matrix3 rotMat = eigenQuaternion(m_coeffs).toRotationMatrix();
+    for (size_t i = 0; i < numStates; i++) {
+      Eigen::Map<const Eigen::Vector3d> positionVector(states + 6 * i);
+      Eigen::Map<const Eigen::Vector3d> velocityVector(states + 6 * i + 3);
+      Eigen::Map<const Eigen::Vector3d> av(angularVelocities + 3 * i);
+      Eigen::Vector3d rotatedPosition = rotMat * positionVector;
+      Eigen::Vector3d rotatedVelocity = rotMat * (velocityVector - av.cross(positionVector));
+      Eigen::Map<Eigen::Vector3d> positionOutput(rotated + 6 * i);
+      Eigen::Map<Eigen::Vector3d> velocityOutput(rotated + 6 * i + 3);
+      positionOutput = rotatedPosition;
+      velocityOutput = rotatedVelocity;
+    }
+  }
+
+
   Rotation Rotation::inverse() const {
-    Eigen::Quaterniond inverseQuat = m_impl->quat.inverse();
+    Eigen::Quaterniond inverseQuat = eigenQuaternion(m_coeffs).inverse();
     return Rotation(inverseQuat.w(), inverseQuat.x(), inverseQuat.y(), inverseQuat.z());
   }
 
 
   Rotation Rotation::operator*(const Rotation& rightRotation) const {
-    Eigen::Quaterniond combinedQuat = m_impl->quat * rightRotation.m_impl->quat;
+    Eigen::Quaterniond combinedQuat = eigenQuaternion(m_coeffs) * eigenQuaternion(rightRotation.m_coeffs);
     return Rotation(combinedQuat.w(), combinedQuat.x(), combinedQuat.y(), combinedQuat.z());
   }
 
@@ -247,20 +368,25 @@ namespace ale {
         double t,
         RotationInterpolation interpType
   ) const {
+    Eigen::Map<const Eigen::Quaterniond> quat = eigenQuaternion(m_coeffs);
+    Eigen::Map<const Eigen::Quaterniond> nextQuat = eigenQuaternion(nextRotation.m_coeffs);
     Eigen::Quaterniond interpQuat;
     switch (interpType) {
       case slerp:
-        interpQuat = m_impl->quat.slerp(t, nextRotation.m_impl->quat);
+        interpQuat = quat.slerp(t, nextQuat);
         break;
       case nlerp:
         interpQuat = Eigen::Quaterniond(
-              linearInterpolate(m_impl->quat.w(), nextRotation.m_impl->quat.w(), t),
-              linearInterpolate(m_impl->quat.x(), nextRotation.m_impl->quat.x(), t),
-              linearInterpolate(m_impl->quat.y(), nextRotation.m_impl->quat.y(), t),
-              linearInterpolate(m_impl->quat.z(), nextRotation.m_impl->quat.z(), t)
+              linearInterpolate(quat.w(), nextQuat.w(), t),
+              linearInterpolate(quat.x(), nextQuat.x(), t),
+              linearInterpolate(quat.y(), nextQuat.y(), t),
+              linearInterpolate(quat.z(), nextQuat.z(), t)
         );
         interpQuat.normalize();
         break;
+      case fastSlerp:
+        interpQuat = fastSlerpQuaternion(quat, nextQuat, quat.dot(nextQuat), t);
+        break;
       default:
         throw std::invalid_argument("Unsupported rotation interpolation type.");
         break;
@@ -268,4 +394,387 @@ namespace ale {
     return Rotation(interpQuat.w(), interpQuat.x(), interpQuat.y(), interpQuat.z());
   }
 
+
+  void Rotation::interpolate(
+        const Rotation& nextRotation,
+        const double *t,
+        size_t numTimes,
+        double *quaternions,
+        RotationInterpolation interpType
+  ) const {
+    if (interpType == fastSlerp) {
+      Eigen::Map<const Eigen::Quaterniond> quat = eigenQuaternion(m_coeffs);
+      Eigen::Map<const Eigen::Quaterniond> nextQuat = eigenQuaternion(nextRotation.m_coeffs);
+      double dot = quat.dot(nextQuat);
+      for (size_t i = 0; i < numTimes; i++) {
+        storeQuaternion(fastSlerpQuaternion(quat, nextQuat, dot, t[i]), quaternions + 4 * i);
+      }
+      return;
+    }
+    if (interpType != slerp && interpType != nlerp) {
+      throw std::invalid_argument("Unsupported rotation interpolation type.");
+    }
+    for (size_t i = 0; i < numTimes; i++) {
+      interpolate(nextRotation, t[i], interpType).toQuaternion(quaternions + 4 * i);
+    }
+  }
+
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // PreparedRotation Class
+  ///////////////////////////////////////////////////////////////////////////////
+
+  PreparedRotation::PreparedRotation(const Rotation& rotation, const double *av) :
+        m_rotation(rotation) {
+    Eigen::Map<Eigen::Quaterniond::Matrix3> rotMat(m_matrix);
+    rotMat = eigenQuaternion(rotation.m_coeffs).toRotationMatrix();
+    Eigen::Map<Eigen::Quaterniond::Matrix3> rotationDerivative(m_derivative);
+    if (av) {
+      rotationDerivative = rotMat * avSkewMatrix(av);
+    }
+    else {
+      rotationDerivative.setZero();
+    }
+  }
+
+
+  void PreparedRotation::toStateRotationMatrix(double *matrix) const noexcept {
+    Eigen::Map<const Eigen::Quaterniond::Matrix3> rotMat(m_matrix);
+    Eigen::Map<const Eigen::Quaterniond::Matrix3> dtMat(m_derivative);
+    for (int row = 0; row < 3; row++) {
+      for (int col = 0; col < 3; col++) {
+        matrix[6 * row + col] = rotMat(row, col);
+        matrix[6 * row + col + 3] = 0.0;
+        matrix[6 * (row + 3) + col] = dtMat(row, col);
+        matrix[6 * (row + 3) + col + 3] = rotMat(row, col);
+      }
+    }
+  }
+
+
+  std::vector<double> PreparedRotation::operator()(const std::vector<double>& vector) const {
+    std::vector<double> rotated(vector.size());
+    if (vector.size() == 3) {
+      apply(vector.data(), rotated.data());
+    }
+    else if (vector.size() == 6) {
+      applyState(vector.data(), rotated.data());
+    }
+    else {
+      throw std::invalid_argument("Vector to rotate is the wrong size.");
+    }
+    return rotated;
+  }
+
+
+  void PreparedRotation::apply(const double *vectors, double *rotated, size_t numVectors) const noexcept {
+    // Rotate each vector into a temporary so that the output can alias the input
+    Eigen::Map<const Eigen::Quaterniond::Matrix3> rotMat(m_matrix);
+    for (size_t i = 0; i < numVectors; i++) {
+      Eigen::Map<const Eigen::Vector3d> vector(vectors + 3 * i);
+      Eigen::Vector3d rotatedVector = rotMat * vector;
+      Eigen::Map<Eigen::Vector3d> output(rotated + 3 * i);
+      output = rotatedVector;
+    }
+  }
+
+
+  void PreparedRotation::applyState(const double *states, double *rotated, size_t numStates) const noexcept {
+    Eigen::Map<const Eigen::Quaterniond::Matrix3> rotMat(m_matrix);
+    Eigen::Map<const Eigen::Quaterniond::Matrix3> rotationDerivative(m_derivative);
+    for (size_t i = 0; i < numStates; i++) {
+      Eigen::Map<const Eigen::Vector3d> positionVector(states + 6 * i);
+      Eigen::Map<const Eigen::Vector3d> velocityVector(states + 6 * i + 3);
+      Eigen::Vector3d rotatedPosition = rotMat * positionVector;
+      Eigen::Vector3d rotatedVelocity = rotMat * velocityVector + rotationDerivative * positionVector;
+      Eigen::Map<Eigen::Vector3d> positionOutput(rotated + 6 * i);
+      Eigen::Map<Eigen::Vector3d> velocityOutput(rotated + 6 * i + 3);
+      positionOutput = rotatedPosition;
+      velocityOutput = rotatedVelocity;
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // TimeDependentRotation Class
+  ///////////////////////////////////////////////////////////////////////////////
+
+  // Samples a time dependent rotation one time at a time. The interpolation
+  // data is prepared once, and sorted times sweep forward through the
+  // intervals.
+  class RotationSampler {
+    public:
+      RotationSampler(const TimeDependentRotation &rotation) : m_rotation(rotation) {
+        size_t numRotations = rotation.size();
+        if (numRotations > 1) {
+          m_interpolator.reset(new RotationInterpolator(
+                MatrixView(rotation.quaternions().data(), 4, numRotations, 1, 4),
+                DataView(rotation.times()), slerp, extrapolateEnds));
+          if (rotation.hasAngularVelocities()) {
+            m_rates.reset(new PiecewisePolynomial(PiecewisePolynomial::linear(
+                  DataView(rotation.times()),
+                  MatrixView(rotation.angularVelocities().data(), 3, numRotations, 1, 3))));
+            m_rates->setExtrapolation(extrapolateEnds);
+          }
+        }
+      }
+
+
+      void sample(double time, double *quaternion, double *angularVelocity) {
+        const std::vector<double> &quaternions = m_rotation.quaternions();
+        const std::vector<double> &times = m_rotation.times();
+        const std::vector<double> &angularVelocities = m_rotation.angularVelocities();
+        if (m_interpolator && m_interpolator->state(time, quaternion, angularVelocity) == outOfRange) {
+          throw std::invalid_argument("Invalid interpolation time, must not be NaN.");
+        }
+
+        if (!m_rotation.hasAngularVelocities()) {
+          // A single rotation is constant
+          if (!m_interpolator) {
+            if (quaternion) {
+              std::copy(quaternions.begin(), quaternions.end(), quaternion);
+            }
+            if (angularVelocity) {
+              std::fill(angularVelocity, angularVelocity + 3, 0.0);
+            }
+          }
+          return;
+        }
+
+        // Linearly interpolate the stored angular velocities
+        if (angularVelocity) {
+          if (m_rates) {
+            m_rates->tryEvaluate(time, angularVelocity);
+          }
+          else {
+            std::copy(angularVelocities.begin(), angularVelocities.end(), angularVelocity);
+          }
+        }
+
+        // Turn at the stored angular velocity of the nearest end outside of the times
+        if (quaternion) {
+          size_t end;
+          if (!m_interpolator || time < times.front()) {
+            end = 0;
+          }
+          else if (time > times.back()) {
+            end = times.size() - 1;
+          }
+          else {
+            return;
+          }
+          Eigen::Map<const Eigen::Vector3d> av(&angularVelocities[3 * end]);
+          storeQuaternion(rotationVectorQuaternion(av * (time - times[end])) *
+                          loadQuaternion(&quaternions[4 * end]), quaternion);
+        }
+      }
+
+    private:
+      const TimeDependentRotation &m_rotation;
+      std::unique_ptr<RotationInterpolator> m_interpolator;
+      std::unique_ptr<PiecewisePolynomial> m_rates;
+  };
+
+
+  // Compose two time dependent rotations at a time
+  static void composeAt(RotationSampler &leftSampler, RotationSampler &rightSampler, double time,
+                        double *quaternion, double *angularVelocity) {
+    double leftCoeffs[4];
+    double rightCoeffs[4];
+    double leftRates[3];
+    double rightRates[3];
+    leftSampler.sample(time, leftCoeffs, leftRates);
+    rightSampler.sample(time, rightCoeffs, rightRates);
+
+    Eigen::Quaterniond leftQuat = loadQuaternion(leftCoeffs);
+    Eigen::Quaterniond rightQuat = loadQuaternion(rightCoeffs);
+    Eigen::Map<const Eigen::Vector3d> leftAv(leftRates);
+    Eigen::Map<const Eigen::Vector3d> rightAv(rightRates);
+    storeQuaternion(leftQuat * rightQuat, quaternion);
+    storeVector(rightQuat.conjugate() * leftAv + rightAv, angularVelocity);
+  }
+
+  TimeDependentRotation::TimeDependentRotation(
+        const std::vector<double>& quaternions,
+        const std::vector<double>& times,
+        const std::vector<double>& angularVelocities
+  ) : m_quaternions(quaternions), m_times(times), m_angularVelocities(angularVelocities) {
+    if (m_times.empty()) {
+      throw std::invalid_argument("At least one time must be input.");
+    }
+    if (m_quaternions.size() != 4 * m_times.size()) {
+      throw std::invalid_argument("Invalid input rotations, expected four components for each time.");
+    }
+    if (!m_angularVelocities.empty() && m_angularVelocities.size() != 3 * m_times.size()) {
+      throw std::invalid_argument("Invalid input angular velocities, expected three components for each time.");
+    }
+    for (size_t i = 1; i < m_times.size(); i++) {
+      if (!(m_times[i] > m_times[i - 1])) {
+        throw std::invalid_argument("Invalid interpolation times, must be strictly increasing.");
+      }
+    }
+    for (size_t i = 0; i < m_times.size(); i++) {
+      Eigen::Map<Eigen::Vector4d> quat(&m_quaternions[4 * i]);
+      quat.normalize();
+    }
+  }
+
+
+  void TimeDependentRotation::interpolate(
+        const double *times,
+        size_t numTimes,
+        double *quaternions,
+        double *angularVelocities
+  ) const {
+    RotationSampler sampler(*this);
+    for (size_t i = 0; i < numTimes; i++) {
+      sampler.sample(times[i],
+                     quaternions ? quaternions + 4 * i : nullptr,
+                     angularVelocities ? angularVelocities + 3 * i : nullptr);
+    }
+  }
+
+  TimeDependentRotation TimeDependentRotation::reinterpolate(const std::vector<double>& times) const {
+    std::vector<double> quaternions(4 * times.size());
+    std::vector<double> angularVelocities(3 * times.size());
+    interpolate(times.data(), times.size(), quaternions.data(), angularVelocities.data());
+    return TimeDependentRotation(quaternions, times, angularVelocities);
+  }
+
+
+  TimeDependentRotation TimeDependentRotation::inverse() const {
+    std::vector<double> quaternions(m_quaternions.size());
+    std::vector<double> angularVelocities(m_angularVelocities.size());
+    for (size_t i = 0; i < size(); i++) {
+      Eigen::Quaterniond quat = loadQuaternion(&m_quaternions[4 * i]);
+      storeQuaternion(quat.conjugate(), &quaternions[4 * i]);
+      if (hasAngularVelocities()) {
+        Eigen::Map<const Eigen::Vector3d> av(&m_angularVelocities[3 * i]);
+        storeVector(-(quat * av), &angularVelocities[3 * i]);
+      }
+    }
+    return TimeDependentRotation(quaternions, m_times, angularVelocities);
+  }
+
+
+  TimeDependentRotation TimeDependentRotation::operator*(const TimeDependentRotation& rightRotation) const {
+    const std::vector<double> &leftTimes = m_times;
+    const std::vector<double> &rightTimes = rightRotation.m_times;
+    std::vector<double> mergedTimes;
+    std::vector<double> quaternions;
+    std::vector<double> angularVelocities;
+    size_t capacity = leftTimes.size() + rightTimes.size();
+    mergedTimes.reserve(capacity);
+    quaternions.reserve(4 * capacity);
+    angularVelocities.reserve(3 * capacity);
+
+    // Merge the times and compose at each one in the same pass
+    RotationSampler leftSampler(*this);
+    RotationSampler rightSampler(rightRotation);
+    size_t leftIndex = 0;
+    size_t rightIndex = 0;
+    while (leftIndex < leftTimes.size() || rightIndex < rightTimes.size()) {
+      double time;
+      if (rightIndex == rightTimes.size() ||
+          (leftIndex < leftTimes.size() && leftTimes[leftIndex] < rightTimes[rightIndex])) {
+        time = leftTimes[leftIndex++];
+      }
+      else if (leftIndex == leftTimes.size() || rightTimes[rightIndex] < leftTimes[leftIndex]) {
+        time = rightTimes[rightIndex++];
+      }
+      else {
+        time = leftTimes[leftIndex++];
+        rightIndex++;
+      }
+      mergedTimes.push_back(time);
+      quaternions.resize(quaternions.size() + 4);
+      angularVelocities.resize(angularVelocities.size() + 3);
+      composeAt(leftSampler, rightSampler, time,
+                &quaternions[quaternions.size() - 4], &angularVelocities[angularVelocities.size() - 3]);
+    }
+    return TimeDependentRotation(quaternions, mergedTimes, angularVelocities);
+  }
+
+
+  TimeDependentRotation TimeDependentRotation::compose(const TimeDependentRotation& rightRotation,
+                                                       const std::vector<double>& times) const {
+    std::vector<double> quaternions(4 * times.size());
+    std::vector<double> angularVelocities(3 * times.size());
+    RotationSampler leftSampler(*this);
+    RotationSampler rightSampler(rightRotation);
+    for (size_t i = 0; i < times.size(); i++) {
+      composeAt(leftSampler, rightSampler, times[i], &quaternions[4 * i], &angularVelocities[3 * i]);
+    }
+    return TimeDependentRotation(quaternions, times, angularVelocities);
+  }
+
+
+  TimeDependentRotation TimeDependentRotation::operator*(const Rotation& rightRotation) const {
+    double rightCoeffs[4];
+    rightRotation.toQuaternion(rightCoeffs);
+    Eigen::Quaterniond rightQuat = loadQuaternion(rightCoeffs);
+    std::vector<double> quaternions(m_quaternions.size());
+    std::vector<double> angularVelocities(m_angularVelocities.size());
+    for (size_t i = 0; i < size(); i++) {
+      storeQuaternion(loadQuaternion(&m_quaternions[4 * i]) * rightQuat, &quaternions[4 * i]);
+      if (hasAngularVelocities()) {
+        Eigen::Map<const Eigen::Vector3d> av(&m_angularVelocities[3 * i]);
+        storeVector(rightQuat.conjugate() * av, &angularVelocities[3 * i]);
+      }
+    }
+    return TimeDependentRotation(quaternions, m_times, angularVelocities);
+  }
+
+
+  TimeDependentRotation operator*(const Rotation& leftRotation, const TimeDependentRotation& rightRotation) {
+    double leftCoeffs[4];
+    leftRotation.toQuaternion(leftCoeffs);
+    Eigen::Quaterniond leftQuat = loadQuaternion(leftCoeffs);
+    const std::vector<double> &rightQuaternions = rightRotation.quaternions();
+    std::vector<double> quaternions(rightQuaternions.size());
+    for (size_t i = 0; i < rightRotation.size(); i++) {
+      storeQuaternion(leftQuat * loadQuaternion(&rightQuaternions[4 * i]), &quaternions[4 * i]);
+    }
+    return TimeDependentRotation(quaternions, rightRotation.times(), rightRotation.angularVelocities());
+  }
+
+
+  void TimeDependentRotation::apply(
+        const double *positions,
+        const double *times,
+        size_t numTimes,
+        double *rotated
+  ) const {
+    std::vector<double> quaternions(4 * numTimes);
+    interpolate(times, numTimes, quaternions.data(), nullptr);
+    for (size_t i = 0; i < numTimes; i++) {
+      Eigen::Map<const Eigen::Vector3d> position(positions + 3 * i);
+      storeVector(loadQuaternion(&quaternions[4 * i]) * position, rotated + 3 * i);
+    }
+  }
+
+
+  void TimeDependentRotation::applyState(
+        const double *positions,
+        const double *velocities,
+        const double *times,
+        size_t numTimes,
+        double *rotatedPositions,
+        double *rotatedVelocities
+  ) const {
+    std::vector<double> quaternions(4 * numTimes);
+    std::vector<double> angularVelocities(3 * numTimes);
+    interpolate(times, numTimes, quaternions.data(), angularVelocities.data());
+    for (size_t i = 0; i < numTimes; i++) {
+      Eigen::Quaterniond quat = loadQuaternion(&quaternions[4 * i]);
+      Eigen::Map<const Eigen::Vector3d> av(&angularVelocities[3 * i]);
+      Eigen::Vector3d position(positions[3 * i], positions[3 * i + 1], positions[3 * i + 2]);
+      Eigen::Vector3d velocity(velocities[3 * i], velocities[3 * i + 1], velocities[3 * i + 2]);
+      // Same as the state rotation in Rotation::operator()
+      storeVector(quat * (velocity - av.cross(position)), rotatedVelocities + 3 * i);
+      if (rotatedPositions) {
+        storeVector(quat * position, rotatedPositions + 3 * i);
+      }
+    }
+  }
+
 }
@@ -0,0 +1,552 @@
+#include "RotationArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace ale {
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // Kernels
+  ///////////////////////////////////////////////////////////////////////////////
+
+  // Each kernel works on separate w, x, y, and z arrays. When the file is
+  // built for AVX2, see ALE_NATIVE_ARCH, four rotations are processed per
+  // iteration and a scalar loop with the same formulas handles the rest.
+  // The kernels are branchless, so every lane follows the same path.
+
+#if defined(__AVX2__)
+  // Take the lanes of b where the mask is set and the lanes of a elsewhere
+  static inline __m256d select(__m256d mask, __m256d a, __m256d b) {
+    return _mm256_blendv_pd(a, b, mask);
+  }
+
+  // Transpose four vectors so that the result holds lane 0 of each, then
+  // lane 1 of each, and so on
+  static inline void transpose(__m256d &r0, __m256d &r1, __m256d &r2, __m256d &r3) {
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+    r0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+    r1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+    r2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+    r3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+  }
+#endif
+
+
+  // Chain each pair of quaternions, left times right
+  static void multiplyQuaternions(const double *lw, const double *lx, const double *ly, const double *lz,
+                                  const double *rw, const double *rx, const double *ry, const double *rz,
+                                  double *w, double *x, double *y, double *z, size_t size) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= size; i += 4) {
+      __m256d aw = _mm256_loadu_pd(lw + i), ax = _mm256_loadu_pd(lx + i);
+      __m256d ay = _mm256_loadu_pd(ly + i), az = _mm256_loadu_pd(lz + i);
+      __m256d bw = _mm256_loadu_pd(rw + i), bx = _mm256_loadu_pd(rx + i);
+      __m256d by = _mm256_loadu_pd(ry + i), bz = _mm256_loadu_pd(rz + i);
+      _mm256_storeu_pd(w + i, _mm256_sub_pd(_mm256_sub_pd(_mm256_sub_pd(
+            _mm256_mul_pd(aw, bw), _mm256_mul_pd(ax, bx)), _mm256_mul_pd(ay, by)), _mm256_mul_pd(az, bz)));
+      _mm256_storeu_pd(x + i, _mm256_sub_pd(_mm256_add_pd(_mm256_add_pd(
+            _mm256_mul_pd(aw, bx), _mm256_mul_pd(ax, bw)), _mm256_mul_pd(ay, bz)), _mm256_mul_pd(az, by)));
+      _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_add_pd(_mm256_sub_pd(
+            _mm256_mul_pd(aw, by), _mm256_mul_pd(ax, bz)), _mm256_mul_pd(ay, bw)), _mm256_mul_pd(az, bx)));
+      _mm256_storeu_pd(z + i, _mm256_add_pd(_mm256_sub_pd(_mm256_add_pd(
+            _mm256_mul_pd(aw, bz), _mm256_mul_pd(ax, by)), _mm256_mul_pd(ay, bx)), _mm256_mul_pd(az, bw)));
+    }
+#endif
+    for (; i < size; i++) {
+      double aw = lw[i], ax = lx[i], ay = ly[i], az = lz[i];
+      double bw = rw[i], bx = rx[i], by = ry[i], bz = rz[i];
+      w[i] = aw * bw - ax * bx - ay * by - az * bz;
+      x[i] = aw * bx + ax * bw + ay * bz - az * by;
+      y[i] = aw * by - ax * bz + ay * bw + az * bx;
+      z[i] = aw * bz + ax * by - ay * bx + az * bw;
+    }
+  }
+
+
+  // Invert each quaternion
+  static void invertQuaternions(const double *qw, const double *qx, const double *qy, const double *qz,
+                                double *w, double *x, double *y, double *z, size_t size) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d signBit = _mm256_set1_pd(-0.0);
+    for (; i + 4 <= size; i += 4) {
+      __m256d vw = _mm256_loadu_pd(qw + i), vx = _mm256_loadu_pd(qx + i);
+      __m256d vy = _mm256_loadu_pd(qy + i), vz = _mm256_loadu_pd(qz + i);
+      __m256d norm = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(
+            _mm256_mul_pd(vw, vw), _mm256_mul_pd(vx, vx)), _mm256_mul_pd(vy, vy)), _mm256_mul_pd(vz, vz));
+      __m256d scale = _mm256_div_pd(one, norm);
+      _mm256_storeu_pd(w + i, _mm256_mul_pd(vw, scale));
+      _mm256_storeu_pd(x + i, _mm256_mul_pd(_mm256_xor_pd(vx, signBit), scale));
+      _mm256_storeu_pd(y + i, _mm256_mul_pd(_mm256_xor_pd(vy, signBit), scale));
+      _mm256_storeu_pd(z + i, _mm256_mul_pd(_mm256_xor_pd(vz, signBit), scale));
+    }
+#endif
+    for (; i < size; i++) {
+      double scale = 1 / (qw[i] * qw[i] + qx[i] * qx[i] + qy[i] * qy[i] + qz[i] * qz[i]);
+      w[i] = qw[i] * scale;
+      x[i] = -qx[i] * scale;
+      y[i] = -qy[i] * scale;
+      z[i] = -qz[i] * scale;
+    }
+  }
+
+
+  // Scale each quaternion to unit length
+  static void normalizeQuaternions(double *w, double *x, double *y, double *z, size_t size) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256d one = _mm256_set1_pd(1.0);
+    for (; i + 4 <= size; i += 4) {
+      __m256d vw = _mm256_loadu_pd(w + i), vx = _mm256_loadu_pd(x + i);
+      __m256d vy = _mm256_loadu_pd(y + i), vz = _mm256_loadu_pd(z + i);
+      __m256d norm = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(
+            _mm256_mul_pd(vw, vw), _mm256_mul_pd(vx, vx)), _mm256_mul_pd(vy, vy)), _mm256_mul_pd(vz, vz));
+      __m256d scale = _mm256_div_pd(one, _mm256_sqrt_pd(norm));
+      _mm256_storeu_pd(w + i, _mm256_mul_pd(vw, scale));
+      _mm256_storeu_pd(x + i, _mm256_mul_pd(vx, scale));
+      _mm256_storeu_pd(y + i, _mm256_mul_pd(vy, scale));
+      _mm256_storeu_pd(z + i, _mm256_mul_pd(vz, scale));
+    }
+#endif
+    for (; i < size; i++) {
+      double scale = 1 / sqrt(w[i] * w[i] + x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+      w[i] *= scale;
+      x[i] *= scale;
+      y[i] *= scale;
+      z[i] *= scale;
+    }
+  }
+
+
+  // Convert each quaternion to a column-major rotation matrix, with the same
+  // formula as Eigen's Quaternion::toRotationMatrix
+  static void quaternionsToMatrices(const double *w, const double *x, const double *y, const double *z,
+                                    size_t size, double *matrices) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d two = _mm256_set1_pd(2.0);
+    double last[4];
+    for (; i + 4 <= size; i += 4) {
+      __m256d vw = _mm256_loadu_pd(w + i), vx = _mm256_loadu_pd(x + i);
+      __m256d vy = _mm256_loadu_pd(y + i), vz = _mm256_loadu_pd(z + i);
+      __m256d tx = _mm256_mul_pd(two, vx), ty = _mm256_mul_pd(two, vy), tz = _mm256_mul_pd(two, vz);
+      __m256d twx = _mm256_mul_pd(tx, vw), twy = _mm256_mul_pd(ty, vw), twz = _mm256_mul_pd(tz, vw);
+      __m256d txx = _mm256_mul_pd(tx, vx), txy = _mm256_mul_pd(ty, vx), txz = _mm256_mul_pd(tz, vx);
+      __m256d tyy = _mm256_mul_pd(ty, vy), tyz = _mm256_mul_pd(tz, vy), tzz = _mm256_mul_pd(tz, vz);
+      __m256d m0 = _mm256_sub_pd(one, _mm256_add_pd(tyy, tzz));
+      __m256d m1 = _mm256_add_pd(txy, twz);
+      __m256d m2 = _mm256_sub_pd(txz, twy);
+      __m256d m3 = _mm256_sub_pd(txy, twz);
+      __m256d m4 = _mm256_sub_pd(one, _mm256_add_pd(txx, tzz));
+      __m256d m5 = _mm256_add_pd(tyz, twx);
+      __m256d m6 = _mm256_add_pd(txz, twy);
+      __m256d m7 = _mm256_sub_pd(tyz, twx);
+      __m256d m8 = _mm256_sub_pd(one, _mm256_add_pd(txx, tyy));
+      // Interleave the lanes into one matrix per rotation, the first eight
+      // elements by transposing and the last one by hand
+      transpose(m0, m1, m2, m3);
+      transpose(m4, m5, m6, m7);
+      _mm256_storeu_pd(last, m8);
+      double *matrix = matrices + 9 * i;
+      _mm256_storeu_pd(matrix, m0);
+      _mm256_storeu_pd(matrix + 4, m4);
+      matrix[8] = last[0];
+      _mm256_storeu_pd(matrix + 9, m1);
+      _mm256_storeu_pd(matrix + 13, m5);
+      matrix[17] = last[1];
+      _mm256_storeu_pd(matrix + 18, m2);
+      _mm256_storeu_pd(matrix + 22, m6);
+      matrix[26] = last[2];
+      _mm256_storeu_pd(matrix + 27, m3);
+      _mm256_storeu_pd(matrix + 31, m7);
+      matrix[35] = last[3];
+    }
+#endif
+    for (; i < size; i++) {
+      double tx = 2 * x[i], ty = 2 * y[i], tz = 2 * z[i];
+      double twx = tx * w[i], twy = ty * w[i], twz = tz * w[i];
+      double txx = tx * x[i], txy = ty * x[i], txz = tz * x[i];
+      double tyy = ty * y[i], tyz = tz * y[i], tzz = tz * z[i];
+      double *matrix = matrices + 9 * i;
+      matrix[0] = 1 - (tyy + tzz);
+      matrix[1] = txy + twz;
+      matrix[2] = txz - twy;
+      matrix[3] = txy - twz;
+      matrix[4] = 1 - (txx + tzz);
+      matrix[5] = tyz + twx;
+      matrix[6] = txz + twy;
+      matrix[7] = tyz - twx;
+      matrix[8] = 1 - (txx + tyy);
+    }
+  }
+
+
+  // Convert each column-major rotation matrix to a unit quaternion.
+  //
+  // This is Shepperd's method as Eigen implements it, which takes the square
+  // root of whichever of the trace and the diagonal gives the most accurate
+  // result. Instead of branching on that choice, the square root argument
+  // and every component are selected from the candidates, so all rotations
+  // take the same path.
+  static void matricesToQuaternions(const double *matrices, size_t size,
+                                    double *w, double *x, double *y, double *z) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d one = _mm256_set1_pd(1.0);
+    for (; i + 4 <= size; i += 4) {
+      // Load four matrices and transpose them so each vector holds one
+      // element of all four
+      const double *matrix = matrices + 9 * i;
+      __m256d m00 = _mm256_loadu_pd(matrix), m10 = _mm256_loadu_pd(matrix + 9);
+      __m256d m20 = _mm256_loadu_pd(matrix + 18), m01 = _mm256_loadu_pd(matrix + 27);
+      __m256d m11 = _mm256_loadu_pd(matrix + 4), m21 = _mm256_loadu_pd(matrix + 13);
+      __m256d m02 = _mm256_loadu_pd(matrix + 22), m12 = _mm256_loadu_pd(matrix + 31);
+      __m256d m22 = _mm256_setr_pd(matrix[8], matrix[17], matrix[26], matrix[35]);
+      transpose(m00, m10, m20, m01);
+      transpose(m11, m21, m02, m12);
+
+      __m256d trace = _mm256_add_pd(_mm256_add_pd(m00, m11), m22);
+      __m256d useTrace = _mm256_cmp_pd(trace, zero, _CMP_GT_OQ);
+      __m256d useY = _mm256_cmp_pd(m11, m00, _CMP_GT_OQ);
+      __m256d useZ = _mm256_cmp_pd(m22, select(useY, m00, m11), _CMP_GT_OQ);
+
+      __m256d argX = _mm256_sub_pd(_mm256_sub_pd(m00, m11), m22);
+      __m256d argY = _mm256_sub_pd(_mm256_sub_pd(m11, m22), m00);
+      __m256d argZ = _mm256_sub_pd(_mm256_sub_pd(m22, m00), m11);
+      __m256d arg = select(useTrace, select(useZ, select(useY, argX, argY), argZ), trace);
+      __m256d t = _mm256_sqrt_pd(_mm256_add_pd(arg, one));
+      __m256d h = _mm256_mul_pd(half, t);
+      __m256d s = _mm256_div_pd(half, t);
+
+      __m256d dx = _mm256_mul_pd(_mm256_sub_pd(m21, m12), s);
+      __m256d dy = _mm256_mul_pd(_mm256_sub_pd(m02, m20), s);
+      __m256d dz = _mm256_mul_pd(_mm256_sub_pd(m10, m01), s);
+      __m256d sxy = _mm256_mul_pd(_mm256_add_pd(m10, m01), s);
+      __m256d sxz = _mm256_mul_pd(_mm256_add_pd(m20, m02), s);
+      __m256d syz = _mm256_mul_pd(_mm256_add_pd(m21, m12), s);
+
+      __m256d qw = select(useTrace, select(useZ, select(useY, dx, dy), dz), h);
+      __m256d qx = select(useTrace, select(useZ, select(useY, h, sxy), sxz), dx);
+      __m256d qy = select(useTrace, select(useZ, select(useY, sxy, h), syz), dy);
+      __m256d qz = select(useTrace, select(useZ, select(useY, sxz, syz), h), dz);
+
+      __m256d norm = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(
+            _mm256_mul_pd(qw, qw), _mm256_mul_pd(qx, qx)), _mm256_mul_pd(qy, qy)), _mm256_mul_pd(qz, qz));
+      __m256d scale = _mm256_div_pd(one, _mm256_sqrt_pd(norm));
+      _mm256_storeu_pd(w + i, _mm256_mul_pd(qw, scale));
+      _mm256_storeu_pd(x + i, _mm256_mul_pd(qx, scale));
+      _mm256_storeu_pd(y + i, _mm256_mul_pd(qy, scale));
+      _mm256_storeu_pd(z + i, _mm256_mul_pd(qz, scale));
+    }
+#endif
+    for (; i < size; i++) {
+      const double *m = matrices + 9 * i;
+      double m00 = m[0], m10 = m[1], m20 = m[2];
+      double m01 = m[3], m11 = m[4], m21 = m[5];
+      double m02 = m[6], m12 = m[7], m22 = m[8];
+
+      double trace = m00 + m11 + m22;
+      bool useTrace = trace > 0;
+      bool useY = m11 > m00;
+      bool useZ = m22 > (useY ? m11 : m00);
+
+      double argX = m00 - m11 - m22;
+      double argY = m11 - m22 - m00;
+      double argZ = m22 - m00 - m11;
+      double arg = useTrace ? trace : useZ ? argZ : useY ? argY : argX;
+      double t = sqrt(arg + 1);
+      double h = 0.5 * t;
+      double s = 0.5 / t;
+
+      double dx = (m21 - m12) * s;
+      double dy = (m02 - m20) * s;
+      double dz = (m10 - m01) * s;
+      double sxy = (m10 + m01) * s;
+      double sxz = (m20 + m02) * s;
+      double syz = (m21 + m12) * s;
+
+      double qw = useTrace ? h : useZ ? dz : useY ? dy : dx;
+      double qx = useTrace ? dx : useZ ? sxz : useY ? sxy : h;
+      double qy = useTrace ? dy : useZ ? syz : useY ? h : sxy;
+      double qz = useTrace ? dz : useZ ? h : useY ? syz : sxz;
+
+      double scale = 1 / sqrt(qw * qw + qx * qx + qy * qy + qz * qz);
+      w[i] = qw * scale;
+      x[i] = qx * scale;
+      y[i] = qy * scale;
+      z[i] = qz * scale;
+    }
+  }
+
+
+  // Multiply every quaternion by a rotation about a single axis. The axis is
+  // a template parameter so that each loop has no branches. There are no
+  // vector sines or cosines, so the half angles are taken four at a time
+  // before the vector update.
+  template <int Axis>
+  static void rotateAboutAxis(double *w, double *x, double *y, double *z,
+                              const DataView &angles, size_t size) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    double cosines[4];
+    double sines[4];
+    for (; i + 4 <= size; i += 4) {
+      for (size_t lane = 0; lane < 4; lane++) {
+        cosines[lane] = cos(angles[i + lane] / 2);
+        sines[lane] = sin(angles[i + lane] / 2);
+      }
+      __m256d c = _mm256_loadu_pd(cosines);
+      __m256d s = _mm256_loadu_pd(sines);
+      __m256d qw = _mm256_loadu_pd(w + i), qx = _mm256_loadu_pd(x + i);
+      __m256d qy = _mm256_loadu_pd(y + i), qz = _mm256_loadu_pd(z + i);
+      __m256d rw, rx, ry, rz;
+      if (Axis == 0) {
+        rw = _mm256_sub_pd(_mm256_mul_pd(qw, c), _mm256_mul_pd(qx, s));
+        rx = _mm256_add_pd(_mm256_mul_pd(qx, c), _mm256_mul_pd(qw, s));
+        ry = _mm256_add_pd(_mm256_mul_pd(qy, c), _mm256_mul_pd(qz, s));
+        rz = _mm256_sub_pd(_mm256_mul_pd(qz, c), _mm256_mul_pd(qy, s));
+      }
+      else if (Axis == 1) {
+        rw = _mm256_sub_pd(_mm256_mul_pd(qw, c), _mm256_mul_pd(qy, s));
+        rx = _mm256_sub_pd(_mm256_mul_pd(qx, c), _mm256_mul_pd(qz, s));
+        ry = _mm256_add_pd(_mm256_mul_pd(qy, c), _mm256_mul_pd(qw, s));
+        rz = _mm256_add_pd(_mm256_mul_pd(qz, c), _mm256_mul_pd(qx, s));
+      }
+      else {
+        rw = _mm256_sub_pd(_mm256_mul_pd(qw, c), _mm256_mul_pd(qz, s));
+        rx = _mm256_add_pd(_mm256_mul_pd(qx, c), _mm256_mul_pd(qy, s));
+        ry = _mm256_sub_pd(_mm256_mul_pd(qy, c), _mm256_mul_pd(qx, s));
+        rz = _mm256_add_pd(_mm256_mul_pd(qz, c), _mm256_mul_pd(qw, s));
+      }
+      _mm256_storeu_pd(w + i, rw);
+      _mm256_storeu_pd(x + i, rx);
+      _mm256_storeu_pd(y + i, ry);
+      _mm256_storeu_pd(z + i, rz);
+    }
+#endif
+    for (; i < size; i++) {
+      double c = cos(angles[i] / 2);
+      double s = sin(angles[i] / 2);
+      double qw = w[i], qx = x[i], qy = y[i], qz = z[i];
+      if (Axis == 0) {
+        w[i] = qw * c - qx * s;
+        x[i] = qx * c + qw * s;
+        y[i] = qy * c + qz * s;
+        z[i] = qz * c - qy * s;
+      }
+      else if (Axis == 1) {
+        w[i] = qw * c - qy * s;
+        x[i] = qx * c - qz * s;
+        y[i] = qy * c + qw * s;
+        z[i] = qz * c + qx * s;
+      }
+      else {
+        w[i] = qw * c - qz * s;
+        x[i] = qx * c + qy * s;
+        y[i] = qy * c - qx * s;
+        z[i] = qz * c + qw * s;
+      }
+    }
+  }
+
+
+  // Euler angles from a column-major rotation matrix, with the same formula
+  // and angle ranges as Eigen's MatrixBase::eulerAngles
+  static void matrixToEuler(const double *matrix, int a0, int a1, int a2, double *angles) {
+    // Element (row, column)
+    #define ALE_M(row, column) matrix[(row) + 3 * (column)]
+    const int odd = ((a0 + 1) % 3 == a1) ? 0 : 1;
+    const int i = a0;
+    const int j = (a0 + 1 + odd) % 3;
+    const int k = (a0 + 2 - odd) % 3;
+
+    if (a0 == a2) {
+      angles[0] = atan2(ALE_M(j, i), ALE_M(k, i));
+      double s2 = sqrt(ALE_M(j, i) * ALE_M(j, i) + ALE_M(k, i) * ALE_M(k, i));
+      if ((odd && angles[0] < 0) || (!odd && angles[0] > 0)) {
+        angles[0] += (angles[0] > 0) ? -M_PI : M_PI;
+        angles[1] = -atan2(s2, ALE_M(i, i));
+      }
+      else {
+        angles[1] = atan2(s2, ALE_M(i, i));
+      }
+      double s1 = sin(angles[0]);
+      double c1 = cos(angles[0]);
+      angles[2] = atan2(c1 * ALE_M(j, k) - s1 * ALE_M(k, k), c1 * ALE_M(j, j) - s1 * ALE_M(k, j));
+    }
+    else {
+      angles[0] = atan2(ALE_M(j, k), ALE_M(k, k));
+      double c2 = sqrt(ALE_M(i, i) * ALE_M(i, i) + ALE_M(i, j) * ALE_M(i, j));
+      if ((odd && angles[0] < 0) || (!odd && angles[0] > 0)) {
+        angles[0] += (angles[0] > 0) ? -M_PI : M_PI;
+        angles[1] = atan2(-ALE_M(i, k), -c2);
+      }
+      else {
+        angles[1] = atan2(-ALE_M(i, k), c2);
+      }
+      double s1 = sin(angles[0]);
+      double c1 = cos(angles[0]);
+      angles[2] = atan2(s1 * ALE_M(k, i) - c1 * ALE_M(j, i), c1 * ALE_M(j, j) - s1 * ALE_M(k, j));
+    }
+    #undef ALE_M
+
+    if (!odd) {
+      angles[0] = -angles[0];
+      angles[1] = -angles[1];
+      angles[2] = -angles[2];
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // RotationArray Class
+  ///////////////////////////////////////////////////////////////////////////////
+
+  RotationArray::RotationArray(size_t size) :
+        m_size(size), m_coeffs(4 * size, 0.0) {
+    fill(m_coeffs.begin(), m_coeffs.begin() + size, 1.0);
+  }
+
+
+  RotationArray::RotationArray(const MatrixView& quaternions) :
+        m_size(quaternions.numSamples()), m_coeffs(4 * quaternions.numSamples()) {
+    if (quaternions.numComponents() != 4) {
+      throw invalid_argument("Invalid input rotations, expected four components.");
+    }
+    for (size_t component = 0; component < 4; component++) {
+      DataView values = quaternions.component(component);
+      double *coeffs = m_coeffs.data() + component * m_size;
+      for (size_t i = 0; i < m_size; i++) {
+        coeffs[i] = values[i];
+      }
+    }
+    normalize();
+  }
+
+
+  RotationArray RotationArray::fromMatrices(const double *matrices, size_t size) {
+    RotationArray rotations(size);
+    double *w = rotations.m_coeffs.data();
+    matricesToQuaternions(matrices, size, w, w + size, w + 2 * size, w + 3 * size);
+    return rotations;
+  }
+
+
+  RotationArray RotationArray::fromEuler(const MatrixView& angles, const std::vector<int>& axes) {
+    if (axes.empty()) {
+      throw invalid_argument("Angles and axes must be non-empty.");
+    }
+    if (angles.numComponents() != axes.size()) {
+      throw invalid_argument("Number of angles and axes must be equal.");
+    }
+    for (int axis : axes) {
+      if (axis < 0 || axis > 2) {
+        throw invalid_argument("Axis index must be 0, 1, or 2.");
+      }
+    }
+
+    size_t size = angles.numSamples();
+    RotationArray rotations(size);
+    double *w = rotations.m_coeffs.data();
+    for (size_t k = 0; k < axes.size(); k++) {
+      double *x = w + size, *y = x + size, *z = y + size;
+      switch (axes[k]) {
+        case 0:
+          rotateAboutAxis<0>(w, x, y, z, angles.component(k), size);
+          break;
+        case 1:
+          rotateAboutAxis<1>(w, x, y, z, angles.component(k), size);
+          break;
+        default:
+          rotateAboutAxis<2>(w, x, y, z, angles.component(k), size);
+          break;
+      }
+    }
+    return rotations;
+  }
+
+
+  RotationArray RotationArray::operator*(const RotationArray& rightRotations) const {
+    if (rightRotations.size() != m_size) {
+      throw invalid_argument("Rotation arrays must be the same size.");
+    }
+
+    RotationArray product(m_size);
+    const double *lw = m_coeffs.data(), *lx = lw + m_size, *ly = lx + m_size, *lz = ly + m_size;
+    const double *rw = rightRotations.m_coeffs.data(), *rx = rw + m_size, *ry = rx + m_size, *rz = ry + m_size;
+    double *w = product.m_coeffs.data(), *x = w + m_size, *y = x + m_size, *z = y + m_size;
+    multiplyQuaternions(lw, lx, ly, lz, rw, rx, ry, rz, w, x, y, z, m_size);
+    return product;
+  }
+
+
+  RotationArray RotationArray::inverse() const {
+    RotationArray inverse(m_size);
+    const double *qw = m_coeffs.data(), *qx = qw + m_size, *qy = qx + m_size, *qz = qy + m_size;
+    double *w = inverse.m_coeffs.data(), *x = w + m_size, *y = x + m_size, *z = y + m_size;
+    invertQuaternions(qw, qx, qy, qz, w, x, y, z, m_size);
+    return inverse;
+  }
+
+
+  void RotationArray::normalize() {
+    double *w = m_coeffs.data();
+    normalizeQuaternions(w, w + m_size, w + 2 * m_size, w + 3 * m_size, m_size);
+  }
+
+
+  void RotationArray::toQuaternions(double *quaternions) const {
+    for (size_t component = 0; component < 4; component++) {
+      const double *coeffs = m_coeffs.data() + component * m_size;
+      for (size_t i = 0; i < m_size; i++) {
+        quaternions[4 * i + component] = coeffs[i];
+      }
+    }
+  }
+
+
+  void RotationArray::toMatrices(double *matrices) const {
+    // Matrices are stored column-major, like Eigen
+    const double *w = m_coeffs.data();
+    quaternionsToMatrices(w, w + m_size, w + 2 * m_size, w + 3 * m_size, m_size, matrices);
+  }
+
+
+  void RotationArray::toEuler(const std::vector<int>& axes, double *angles) const {
+    if (axes.size() != 3) {
+      throw invalid_argument("Must have 3 axes to convert to Euler angles.");
+    }
+    if (axes[0] < 0 || axes[0] > 2 ||
+        axes[1] < 0 || axes[1] > 2 ||
+        axes[2] < 0 || axes[2] > 2) {
+      throw invalid_argument("Invalid axis number.");
+    }
+
+    // Build the matrices a block at a time with the matrix kernel, then take
+    // the angles from each one. The arc tangents have no vector instructions.
+    const size_t blockSize = 64;
+    double matrices[9 * blockSize];
+    const double *w = m_coeffs.data(), *x = w + m_size, *y = x + m_size, *z = y + m_size;
+    for (size_t start = 0; start < m_size; start += blockSize) {
+      size_t count = min(blockSize, m_size - start);
+      quaternionsToMatrices(w + start, x + start, y + start, z + start, count, matrices);
+      for (size_t i = 0; i < count; i++) {
+        matrixToEuler(matrices + 9 * i, axes[0], axes[1], axes[2], angles + 3 * (start + i));
+      }
+    }
+  }
+}
@@ -0,0 +1,333 @@
+#include "RotationInterpolator.h"
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+namespace ale {
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // Quaternion Helpers
+  ///////////////////////////////////////////////////////////////////////////////
+
+  // Quaternions are stored w, x, y, z, but Eigen stores them x, y, z, w
+  static Eigen::Quaterniond loadQuaternion(const double *data) {
+    return Eigen::Quaterniond(data[0], data[1], data[2], data[3]);
+  }
+
+
+  static void storeQuaternion(const Eigen::Quaterniond &quat, double *data) {
+    data[0] = quat.w();
+    data[1] = quat.x();
+    data[2] = quat.y();
+    data[3] = quat.z();
+  }
+
+
+  // The product of two quaternions with a pure quaternion on the right
+  static Eigen::Quaterniond pureProduct(const Eigen::Quaterniond &quat, const Eigen::Vector3d &vec) {
+    return quat * Eigen::Quaterniond(0, vec.x(), vec.y(), vec.z());
+  }
+
+
+  // The logarithm of a unit quaternion, half of its rotation vector
+  static Eigen::Vector3d quaternionLog(const Eigen::Quaterniond &quat) {
+    double sinAngle = quat.vec().norm();
+    if (sinAngle < 1e-12) {
+      return quat.vec();
+    }
+    return quat.vec() * (atan2(sinAngle, quat.w()) / sinAngle);
+  }
+
+
+  // The exponential of a pure quaternion
+  static Eigen::Quaterniond quaternionExp(const Eigen::Vector3d &vec) {
+    double angle = vec.norm();
+    double sinc = angle < 1e-8 ? 1 - angle * angle / 6 : sin(angle) / angle;
+    return Eigen::Quaterniond(cos(angle), sinc * vec.x(), sinc * vec.y(), sinc * vec.z());
+  }
+
+
+  // The angular velocity in the destination frame of a rotation and its time derivative
+  static Eigen::Vector3d spatialAngularVelocity(const Eigen::Quaterniond &quat,
+                                                const Eigen::Quaterniond &dQuat) {
+    return 2 * (dQuat * quat.conjugate()).vec();
+  }
+
+
+  // The time derivative of the logarithm of a unit quaternion. Writing the
+  // quaternion as (cos(a), sin(a) n), its logarithm is v * a / sin(a), where
+  // v is its vector part.
+  static Eigen::Vector3d quaternionLogDerivative(const Eigen::Quaterniond &quat,
+                                                 const Eigen::Quaterniond &dQuat) {
+    double sinAngle = quat.vec().norm();
+    double angle = atan2(sinAngle, quat.w());
+    double scale, scaleDerivative;
+    if (angle < 1e-4) {
+      scale = 1 + angle * angle / 6;
+      scaleDerivative = 1.0 / 3 + 2 * angle * angle / 15;
+    }
+    else {
+      scale = angle / sinAngle;
+      scaleDerivative = (sinAngle - angle * cos(angle)) / (sinAngle * sinAngle * sinAngle);
+    }
+    double angleRate = quat.w() * quat.vec().dot(dQuat.vec()) - sinAngle * sinAngle * dQuat.w();
+    return scale * dQuat.vec() + scaleDerivative * angleRate * quat.vec();
+  }
+
+
+  // The time derivative of the exponential of a pure quaternion
+  static Eigen::Quaterniond quaternionExpDerivative(const Eigen::Vector3d &vec,
+                                                    const Eigen::Vector3d &dVec) {
+    double angle = vec.norm();
+    double sinc, sincDerivative;
+    if (angle < 1e-4) {
+      sinc = 1 - angle * angle / 6;
+      sincDerivative = 1.0 / 3 - angle * angle / 30;
+    }
+    else {
+      sinc = sin(angle) / angle;
+      sincDerivative = (sin(angle) - angle * cos(angle)) / (angle * angle * angle);
+    }
+    double dot = vec.dot(dVec);
+    Eigen::Vector3d dVector = sinc * dVec - sincDerivative * dot * vec;
+    return Eigen::Quaterniond(-sinc * dot, dVector.x(), dVector.y(), dVector.z());
+  }
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // RotationInterpolator Class
+  ///////////////////////////////////////////////////////////////////////////////
+
+  RotationInterpolator::RotationInterpolator(const MatrixView& quaternions, const DataView& times,
+                                             RotationInterpolation interp, extrapolation mode) :
+        m_uniform(false), m_interp(interp), m_extrapolation(mode) {
+    if (quaternions.numSamples() != times.size()) {
+      throw invalid_argument("Invalid interpolation data, must have the same number of points as times.");
+    }
+    m_times.resize(times.size());
+    for (size_t i = 0; i < times.size(); i++) {
+      m_times[i] = times[i];
+      if (i > 0 && m_times[i] <= m_times[i - 1]) {
+        throw invalid_argument("Invalid interpolation times, must be strictly increasing.");
+      }
+    }
+    prepare(quaternions);
+  }
+
+
+  RotationInterpolator::RotationInterpolator(const MatrixView& quaternions, const UniformTimeGrid& times,
+                                             RotationInterpolation interp, extrapolation mode) :
+        m_grid(times), m_uniform(true), m_interp(interp), m_extrapolation(mode) {
+    if (quaternions.numSamples() != times.size()) {
+      throw invalid_argument("Invalid interpolation data, must have the same number of points as times.");
+    }
+    prepare(quaternions);
+  }
+
+
+  RotationInterpolator::RotationInterpolator(const QuaternionTable& rotations,
+                                             RotationInterpolation interp, extrapolation mode) :
+        m_uniform(rotations.isUniform()), m_interp(interp), m_extrapolation(mode) {
+    if (m_uniform) {
+      m_grid = rotations.grid();
+    }
+    else {
+      m_times.assign(rotations.times(), rotations.times() + rotations.size());
+      for (size_t i = 1; i < m_times.size(); i++) {
+        if (m_times[i] <= m_times[i - 1]) {
+          throw invalid_argument("Invalid interpolation times, must be strictly increasing.");
+        }
+      }
+    }
+    prepare(rotations.quaternionsView());
+  }
+
+
+  void RotationInterpolator::prepare(const MatrixView& quaternions) {
+    if (quaternions.numComponents() != 4) {
+      throw invalid_argument("Invalid input rotations, expected four components.");
+    }
+    if (m_interp != slerp && m_interp != nlerp && m_interp != squad && m_interp != fastSlerp) {
+      throw invalid_argument("Unsupported rotation interpolation type.");
+    }
+    size_t numRotations = quaternions.numSamples();
+    if (numRotations < 2) {
+      throw invalid_argument("At least two points must be input to interpolate over.");
+    }
+
+    // Normalize and put each quaternion in the same hemisphere as the one before it
+    m_quaternions.resize(4 * numRotations);
+    for (size_t i = 0; i < numRotations; i++) {
+      Eigen::Quaterniond quat(quaternions(0, i), quaternions(1, i),
+                              quaternions(2, i), quaternions(3, i));
+      quat.normalize();
+      if (i > 0 && quat.dot(loadQuaternion(&m_quaternions[4 * (i - 1)])) < 0) {
+        quat.coeffs() *= -1;
+      }
+      storeQuaternion(quat, &m_quaternions[4 * i]);
+    }
+
+    m_angularVelocities.resize(3 * (numRotations - 1));
+    for (size_t i = 0; i + 1 < numRotations; i++) {
+      Eigen::Quaterniond step = loadQuaternion(&m_quaternions[4 * (i + 1)]) *
+                                loadQuaternion(&m_quaternions[4 * i]).conjugate();
+      Eigen::Map<Eigen::Vector3d> av(&m_angularVelocities[3 * i]);
+      av = 2 * quaternionLog(step) / (time(i + 1) - time(i));
+    }
+
+    // Shoemake's control points, which match the tangents on either side
+    // of each interior rotation. The end rotations are their own controls.
+    if (m_interp == squad) {
+      m_controls = m_quaternions;
+      for (size_t i = 1; i + 1 < numRotations; i++) {
+        Eigen::Quaterniond quat = loadQuaternion(&m_quaternions[4 * i]);
+        Eigen::Vector3d tangent = quaternionLog(quat.conjugate() * loadQuaternion(&m_quaternions[4 * (i + 1)])) +
+                                  quaternionLog(quat.conjugate() * loadQuaternion(&m_quaternions[4 * (i - 1)]));
+        storeQuaternion(quat * quaternionExp(-tangent / 4), &m_controls[4 * i]);
+      }
+    }
+  }
+
+
+  size_t RotationInterpolator::findInterval(double time) {
+    size_t interval = m_uniform ? m_grid.interval(time)
+                                : m_cursor.find(m_times.data(), m_times.size(), time);
+    if (interval > 0 && time == this->time(interval)) {
+      interval--;
+    }
+    return interval;
+  }
+
+
+  evaluationStatus RotationInterpolator::rotation(double time, double *quaternion) noexcept {
+    return state(time, quaternion, nullptr);
+  }
+
+
+  evaluationStatus RotationInterpolator::state(double time, double *quaternion,
+                                               double *angularVelocity) noexcept {
+    double first = this->time(0);
+    double last = this->time(size() - 1);
+    if (time >= first && time <= last) {
+      evaluateInterval(findInterval(time), time, quaternion, angularVelocity);
+      return evaluated;
+    }
+    // NaN fails both comparisons
+    if (!(time < first || time > last)) {
+      return outOfRange;
+    }
+
+    size_t interval = time < first ? 0 : size() - 2;
+    switch (m_extrapolation) {
+      case clampToEnds:
+        if (quaternion) {
+          const double *end = &m_quaternions[time < first ? 0 : 4 * (size() - 1)];
+          copy(end, end + 4, quaternion);
+        }
+        if (angularVelocity) {
+          fill(angularVelocity, angularVelocity + 3, 0.0);
+        }
+        return clamped;
+      case extrapolateEnds:
+        evaluateInterval(interval, time, quaternion, angularVelocity);
+        return extrapolated;
+      default:
+        return outOfRange;
+    }
+  }
+
+
+  evaluationStatus RotationInterpolator::states(const double *times, size_t numTimes,
+                                                double *quaternions,
+                                                double *angularVelocities) noexcept {
+    evaluationStatus worst = evaluated;
+    for (size_t i = 0; i < numTimes; i++) {
+      evaluationStatus status = state(times[i],
+                                      quaternions ? quaternions + 4 * i : nullptr,
+                                      angularVelocities ? angularVelocities + 3 * i : nullptr);
+      worst = max(worst, status);
+    }
+    return worst;
+  }
+
+
+  void RotationInterpolator::evaluateInterval(size_t interval, double time, double *quaternion,
+                                              double *angularVelocity) const {
+    double start = this->time(interval);
+    double duration = this->time(interval + 1) - start;
+    double s = (time - start) / duration;
+    Eigen::Quaterniond quat0 = loadQuaternion(&m_quaternions[4 * interval]);
+    Eigen::Quaterniond quat1 = loadQuaternion(&m_quaternions[4 * (interval + 1)]);
+    Eigen::Map<const Eigen::Vector3d> intervalAv(&m_angularVelocities[3 * interval]);
+
+    Eigen::Quaterniond quat;
+    Eigen::Vector3d av;
+    if (m_interp == nlerp && s >= 0 && s <= 1) {
+      Eigen::Quaterniond lerp;
+      lerp.coeffs() = (1 - s) * quat0.coeffs() + s * quat1.coeffs();
+      Eigen::Quaterniond dLerp;
+      dLerp.coeffs() = (quat1.coeffs() - quat0.coeffs()) / duration;
+      av = spatialAngularVelocity(lerp, dLerp) / lerp.squaredNorm();
+      quat = lerp.normalized();
+    }
+    else if (m_interp == fastSlerp && s >= 0 && s <= 1) {
+      // The angular velocity of the exact slerp is the interval's
+      double interpCoeffs[4];
+      Rotation(quat0.w(), quat0.x(), quat0.y(), quat0.z()).interpolate(
+            Rotation(quat1.w(), quat1.x(), quat1.y(), quat1.z()), &s, 1, interpCoeffs, fastSlerp);
+      quat = loadQuaternion(interpCoeffs);
+      av = intervalAv;
+    }
+    else if (m_interp == squad && s >= 0 && s <= 1) {
+      // squad(s) = slerp(slerp(q0, q1, s), slerp(c0, c1, s), 2s(1 - s)) = U exp(u log(U^-1 V))
+      Eigen::Quaterniond control0 = loadQuaternion(&m_controls[4 * interval]);
+      Eigen::Quaterniond control1 = loadQuaternion(&m_controls[4 * (interval + 1)]);
+      Eigen::Vector3d rotationLog = quaternionLog(quat0.conjugate() * quat1) / duration;
+      Eigen::Vector3d controlLog = quaternionLog(control0.conjugate() * control1) / duration;
+      double elapsed = time - start;
+
+      Eigen::Quaterniond outer = quat0 * quaternionExp(elapsed * rotationLog);
+      Eigen::Quaterniond inner = control0 * quaternionExp(elapsed * controlLog);
+      Eigen::Quaterniond dOuter = pureProduct(outer, rotationLog);
+
+      Eigen::Quaterniond blend = outer.conjugate() * inner;
+      Eigen::Quaterniond dBlend;
+      dBlend.coeffs() = pureProduct(blend, controlLog).coeffs() -
+                        (Eigen::Quaterniond(0, rotationLog.x(), rotationLog.y(), rotationLog.z()) * blend).coeffs();
+
+      double weight = 2 * s * (1 - s);
+      double dWeight = 2 * (1 - 2 * s) / duration;
+      Eigen::Vector3d blendLog = quaternionLog(blend);
+      Eigen::Vector3d exponent = weight * blendLog;
+      Eigen::Vector3d dExponent = dWeight * blendLog + weight * quaternionLogDerivative(blend, dBlend);
+
+      Eigen::Quaterniond power = quaternionExp(exponent);
+      Eigen::Quaterniond dPower = quaternionExpDerivative(exponent, dExponent);
+      quat = outer * power;
+      Eigen::Quaterniond dQuat;
+      dQuat.coeffs() = (dOuter * power).coeffs() + (outer * dPower).coeffs();
+      av = spatialAngularVelocity(quat, dQuat);
+      quat.normalize();
+    }
+    else {
+      // Turn at the constant angular velocity of the interval, which is also
+      // how every type extrapolates
+      quat = quaternionExp(intervalAv * (time - start) / 2) * quat0;
+      av = intervalAv;
+    }
+
+    if (quaternion) {
+      storeQuaternion(quat, quaternion);
+    }
+    if (angularVelocity) {
+      angularVelocity[0] = av.x();
+      angularVelocity[1] = av.y();
+      angularVelocity[2] = av.z();
+    }
+  }
+}
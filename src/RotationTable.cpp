@@ -0,0 +1,202 @@
+#include "RotationTable.h"
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace ale {
+
+  // Copy a view of w, x, y, z components into column-major storage,
+  // normalize each quaternion, and flip any quaternion that is in the
+  // opposite hemisphere from the one before it. q and -q are the same
+  // rotation, but interpolating between opposite signs takes the long way
+  // around.
+  static vector<double> alignedQuaternions(const MatrixView &quaternions) {
+    if (quaternions.numComponents() != 4) {
+      throw invalid_argument("Invalid input rotations, expected four components.");
+    }
+
+    size_t numRotations = quaternions.numSamples();
+    vector<double> aligned(4 * numRotations);
+    Eigen::Quaterniond previous(1, 0, 0, 0);
+    for (size_t i = 0; i < numRotations; i++) {
+      Eigen::Quaterniond quat(quaternions(0, i), quaternions(1, i),
+                              quaternions(2, i), quaternions(3, i));
+      quat.normalize();
+      if (i > 0 && quat.dot(previous) < 0) {
+        quat.coeffs() *= -1;
+      }
+      previous = quat;
+
+      aligned[i] = quat.w();
+      aligned[numRotations + i] = quat.x();
+      aligned[2 * numRotations + i] = quat.y();
+      aligned[3 * numRotations + i] = quat.z();
+    }
+    return aligned;
+  }
+
+
+  // Build the polynomials over the normalized, sign aligned quaternions
+  template <typename Times>
+  static PiecewisePolynomial quaternionPolynomial(const MatrixView &quaternions, const Times &times,
+                                                  interpolation interp, extrapolation mode) {
+    vector<double> aligned = alignedQuaternions(quaternions);
+    size_t numRotations = aligned.size() / 4;
+    PiecewisePolynomial poly = PiecewisePolynomial::fromInterpolation(
+          times, MatrixView(aligned.data(), 4, numRotations, numRotations, 1), interp);
+    poly.setExtrapolation(mode);
+    return poly;
+  }
+
+
+  // Build cubic Hermite polynomials over the normalized, sign aligned
+  // quaternions. The derivative of each quaternion comes from its angular
+  // velocity, so the interpolated angular velocity matches the input
+  // angular velocities at each time.
+  template <typename Times>
+  static PiecewisePolynomial hermitePolynomial(const MatrixView &quaternions,
+                                               const MatrixView &angularVelocities,
+                                               const Times &times, extrapolation mode,
+                                               angularVelocityConvention convention) {
+    if (angularVelocities.numComponents() != 3) {
+      throw invalid_argument("Invalid input angular velocities, expected three components.");
+    }
+    if (angularVelocities.numSamples() != quaternions.numSamples()) {
+      throw invalid_argument("Invalid input angular velocities, must have one for each rotation.");
+    }
+
+    vector<double> aligned = alignedQuaternions(quaternions);
+    size_t numRotations = aligned.size() / 4;
+    vector<double> derivatives(4 * numRotations);
+    for (size_t i = 0; i < numRotations; i++) {
+      Eigen::Quaterniond quat(aligned[i], aligned[numRotations + i],
+                              aligned[2 * numRotations + i], aligned[3 * numRotations + i]);
+      Eigen::Quaterniond av(0, angularVelocities(0, i), angularVelocities(1, i), angularVelocities(2, i));
+      Eigen::Quaterniond dQuat;
+      if (convention == destinationFrame) {
+        dQuat.coeffs() = 0.5 * (av * quat).coeffs();
+      }
+      else {
+        dQuat.coeffs() = -0.5 * (quat * av).coeffs();
+      }
+      derivatives[i] = dQuat.w();
+      derivatives[numRotations + i] = dQuat.x();
+      derivatives[2 * numRotations + i] = dQuat.y();
+      derivatives[3 * numRotations + i] = dQuat.z();
+    }
+
+    PiecewisePolynomial poly = PiecewisePolynomial::hermite(
+          times,
+          MatrixView(aligned.data(), 4, numRotations, numRotations, 1),
+          MatrixView(derivatives.data(), 4, numRotations, numRotations, 1));
+    poly.setExtrapolation(mode);
+    return poly;
+  }
+
+
+  // Build the polynomials over a table, using its angular velocities for
+  // Hermite interpolation
+  static PiecewisePolynomial tablePolynomial(const QuaternionTable &rotations, interpolation interp,
+                                             extrapolation mode, angularVelocityConvention convention) {
+    if (interp == hermite) {
+      if (!rotations.hasAngularVelocities()) {
+        throw invalid_argument("Hermite interpolation requires a table with angular velocities.");
+      }
+      if (rotations.isUniform()) {
+        return hermitePolynomial(rotations.quaternionsView(), rotations.angularVelocitiesView(),
+                                 rotations.grid(), mode, convention);
+      }
+      return hermitePolynomial(rotations.quaternionsView(), rotations.angularVelocitiesView(),
+                               rotations.timesView(), mode, convention);
+    }
+    if (rotations.isUniform()) {
+      return quaternionPolynomial(rotations.quaternionsView(), rotations.grid(), interp, mode);
+    }
+    return quaternionPolynomial(rotations.quaternionsView(), rotations.timesView(), interp, mode);
+  }
+
+
+  RotationTable::RotationTable(const MatrixView& quaternions, const DataView& times,
+                               interpolation interp, extrapolation mode) :
+        m_quaternions(quaternionPolynomial(quaternions, times, interp, mode)) { }
+
+
+  RotationTable::RotationTable(const MatrixView& quaternions, const UniformTimeGrid& times,
+                               interpolation interp, extrapolation mode) :
+        m_quaternions(quaternionPolynomial(quaternions, times, interp, mode)) { }
+
+
+  RotationTable::RotationTable(const MatrixView& quaternions, const MatrixView& angularVelocities,
+                               const DataView& times, extrapolation mode,
+                               angularVelocityConvention convention) :
+        m_quaternions(hermitePolynomial(quaternions, angularVelocities, times, mode, convention)) { }
+
+
+  RotationTable::RotationTable(const MatrixView& quaternions, const MatrixView& angularVelocities,
+                               const UniformTimeGrid& times, extrapolation mode,
+                               angularVelocityConvention convention) :
+        m_quaternions(hermitePolynomial(quaternions, angularVelocities, times, mode, convention)) { }
+
+
+  RotationTable::RotationTable(const QuaternionTable& rotations, interpolation interp,
+                               extrapolation mode, angularVelocityConvention convention) :
+        m_quaternions(tablePolynomial(rotations, interp, mode, convention)) { }
+
+
+  evaluationStatus RotationTable::rotation(double time, double *quaternion) noexcept {
+    return state(time, quaternion, nullptr);
+  }
+
+
+  evaluationStatus RotationTable::angularVelocity(double time, double *angularVelocity) noexcept {
+    return state(time, nullptr, angularVelocity);
+  }
+
+
+  evaluationStatus RotationTable::state(double time, double *quaternion,
+                                        double *angularVelocity) noexcept {
+    double q[4];
+    double dq[4];
+    evaluationStatus status = m_quaternions.tryEvaluate(time, q, angularVelocity ? dq : nullptr);
+    if (status == outOfRange) {
+      return status;
+    }
+
+    // The interpolated components are not a unit quaternion in general
+    Eigen::Quaterniond quat(q[0], q[1], q[2], q[3]);
+    quat.normalize();
+    if (quaternion) {
+      quaternion[0] = quat.w();
+      quaternion[1] = quat.x();
+      quaternion[2] = quat.y();
+      quaternion[3] = quat.z();
+    }
+    if (angularVelocity) {
+      Eigen::Quaterniond dQuat(dq[0], dq[1], dq[2], dq[3]);
+      Eigen::Quaterniond avQuat = quat.conjugate() * dQuat;
+      angularVelocity[0] = -2 * avQuat.x();
+      angularVelocity[1] = -2 * avQuat.y();
+      angularVelocity[2] = -2 * avQuat.z();
+    }
+    return status;
+  }
+
+
+  evaluationStatus RotationTable::states(const double *times, size_t numTimes,
+                                         double *quaternions, double *angularVelocities) noexcept {
+    evaluationStatus worst = evaluated;
+    for (size_t i = 0; i < numTimes; i++) {
+      evaluationStatus status = state(times[i],
+                                      quaternions ? quaternions + 4 * i : nullptr,
+                                      angularVelocities ? angularVelocities + 3 * i : nullptr);
+      worst = max(worst, status);
+    }
+    return worst;
+  }
+}
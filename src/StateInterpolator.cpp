@@ -0,0 +1,79 @@
+#include "StateInterpolator.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace ale {
+
+  // Build the polynomials over the positions of a table, using the
+  // velocities for Hermite interpolation
+  static PiecewisePolynomial statePolynomial(const StateTable& states, interpolation interp) {
+    if (interp == hermite) {
+      if (!states.hasVelocities()) {
+        throw invalid_argument("Hermite interpolation requires a table with velocities.");
+      }
+      if (states.isUniform()) {
+        return PiecewisePolynomial::hermite(states.grid(), states.positionsView(),
+                                            states.velocitiesView());
+      }
+      return PiecewisePolynomial::hermite(states.timesView(), states.positionsView(),
+                                          states.velocitiesView());
+    }
+    if (states.isUniform()) {
+      return PiecewisePolynomial::fromInterpolation(states.grid(), states.positionsView(), interp);
+    }
+    return PiecewisePolynomial::fromInterpolation(states.timesView(), states.positionsView(), interp);
+  }
+
+
+  // Check that a view holds positions
+  static const MatrixView& checkPositions(const MatrixView& positions) {
+    if (positions.numComponents() != 3) {
+      throw invalid_argument("Invalid input positions, expected three components.");
+    }
+    return positions;
+  }
+
+
+  StateInterpolator::StateInterpolator(const StateTable& states, interpolation interp,
+                                       extrapolation mode) :
+        m_positions(statePolynomial(states, interp)) {
+    m_positions.setExtrapolation(mode);
+  }
+
+
+  StateInterpolator::StateInterpolator(const MatrixView& positions, const DataView& times,
+                                       interpolation interp, extrapolation mode) :
+        m_positions(PiecewisePolynomial::fromInterpolation(times, checkPositions(positions), interp)) {
+    m_positions.setExtrapolation(mode);
+  }
+
+
+  StateInterpolator::StateInterpolator(const MatrixView& positions, const UniformTimeGrid& times,
+                                       interpolation interp, extrapolation mode) :
+        m_positions(PiecewisePolynomial::fromInterpolation(times, checkPositions(positions), interp)) {
+    m_positions.setExtrapolation(mode);
+  }
+
+
+  evaluationStatus StateInterpolator::position(double time, double *position) noexcept {
+    return m_positions.tryEvaluate(time, position);
+  }
+
+
+  evaluationStatus StateInterpolator::velocity(double time, double *velocity) noexcept {
+    return m_positions.tryEvaluate(time, nullptr, velocity);
+  }
+
+
+  evaluationStatus StateInterpolator::state(double time, double *position, double *velocity) noexcept {
+    return m_positions.tryEvaluate(time, position, velocity);
+  }
+
+
+  evaluationStatus StateInterpolator::states(const double *times, size_t numTimes,
+                                             double *positions, double *velocities) noexcept {
+    return m_positions.tryEvaluate(times, numTimes, positions, velocities);
+  }
+}
@@ -0,0 +1,126 @@
+#include "Tables.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace ale {
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // SampledTable Class
+  ///////////////////////////////////////////////////////////////////////////////
+
+  SampledTable::SampledTable(size_t numSamples, size_t numColumns) :
+        m_size(numSamples), m_uniform(false) {
+    // Pad each column out to a multiple of 8 doubles so every column starts
+    // on a 64 byte boundary.
+    m_columnStride = (numSamples + 7) & ~static_cast<size_t>(7);
+    m_data.assign((numColumns + 1) * m_columnStride, 0.0);
+  }
+
+
+  SampledTable::SampledTable(const UniformTimeGrid& grid, size_t numColumns) :
+        m_size(grid.size()), m_uniform(true), m_grid(grid) {
+    m_columnStride = (m_size + 7) & ~static_cast<size_t>(7);
+    m_data.assign(numColumns * m_columnStride, 0.0);
+  }
+
+
+  void SampledTable::setColumns(size_t first, const vector<vector<double>>& components) {
+    for (size_t i = 0; i < components.size(); i++) {
+      if (components[i].size() != m_size) {
+        throw invalid_argument("Invalid table data, must have the same number of values as times.");
+      }
+      std::copy(components[i].begin(), components[i].end(), column(first + i));
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // StateTable Class
+  ///////////////////////////////////////////////////////////////////////////////
+
+  StateTable::StateTable(size_t numStates, bool hasVelocities) :
+        SampledTable(numStates, hasVelocities ? 6 : 3),
+        m_hasVelocities(hasVelocities) { }
+
+
+  StateTable::StateTable(const vector<double>& times,
+                         const vector<vector<double>>& positions,
+                         const vector<vector<double>>& velocities) :
+        StateTable(times.size(), !velocities.empty()) {
+    if (positions.size() != 3) {
+      throw invalid_argument("Invalid input positions, expected three vectors.");
+    }
+    if (!velocities.empty() && velocities.size() != 3) {
+      throw invalid_argument("Invalid input velocities, expected three vectors.");
+    }
+    std::copy(times.begin(), times.end(), this->times());
+    setColumns(1, positions);
+    setColumns(4, velocities);
+  }
+
+
+  StateTable::StateTable(const UniformTimeGrid& grid, bool hasVelocities) :
+        SampledTable(grid, hasVelocities ? 6 : 3),
+        m_hasVelocities(hasVelocities) { }
+
+
+  StateTable::StateTable(const UniformTimeGrid& grid,
+                         const vector<vector<double>>& positions,
+                         const vector<vector<double>>& velocities) :
+        StateTable(grid, !velocities.empty()) {
+    if (positions.size() != 3) {
+      throw invalid_argument("Invalid input positions, expected three vectors.");
+    }
+    if (!velocities.empty() && velocities.size() != 3) {
+      throw invalid_argument("Invalid input velocities, expected three vectors.");
+    }
+    setColumns(1, positions);
+    setColumns(4, velocities);
+  }
+
+  ///////////////////////////////////////////////////////////////////////////////
+  // QuaternionTable Class
+  ///////////////////////////////////////////////////////////////////////////////
+
+  QuaternionTable::QuaternionTable(size_t numRotations, bool hasAngularVelocities) :
+        SampledTable(numRotations, hasAngularVelocities ? 7 : 4),
+        m_hasAngularVelocities(hasAngularVelocities) { }
+
+
+  QuaternionTable::QuaternionTable(const vector<double>& times,
+                                   const vector<vector<double>>& quaternions,
+                                   const vector<vector<double>>& angularVelocities) :
+        QuaternionTable(times.size(), !angularVelocities.empty()) {
+    if (quaternions.size() != 4) {
+      throw invalid_argument("Invalid input rotations, expected four vectors.");
+    }
+    if (!angularVelocities.empty() && angularVelocities.size() != 3) {
+      throw invalid_argument("Invalid input angular velocities, expected three vectors.");
+    }
+    std::copy(times.begin(), times.end(), this->times());
+    setColumns(1, quaternions);
+    setColumns(5, angularVelocities);
+  }
+
+
+  QuaternionTable::QuaternionTable(const UniformTimeGrid& grid, bool hasAngularVelocities) :
+        SampledTable(grid, hasAngularVelocities ? 7 : 4),
+        m_hasAngularVelocities(hasAngularVelocities) { }
+
+
+  QuaternionTable::QuaternionTable(const UniformTimeGrid& grid,
+                                   const vector<vector<double>>& quaternions,
+                                   const vector<vector<double>>& angularVelocities) :
+        QuaternionTable(grid, !angularVelocities.empty()) {
+    if (quaternions.size() != 4) {
+      throw invalid_argument("Invalid input rotations, expected four vectors.");
+    }
+    if (!angularVelocities.empty() && angularVelocities.size() != 3) {
+      throw invalid_argument("Invalid input angular velocities, expected three vectors.");
+    }
+    setColumns(1, quaternions);
+    setColumns(5, angularVelocities);
+  }
+}
@@ -4,7 +4,6 @@
 
 #include <gsl/gsl_interp.h>
 #include <gsl/gsl_spline.h>
-#include <gsl/gsl_poly.h>
 
 #include <Eigen/Core>
 #include <Eigen/Geometry>
@@ -21,26 +20,74 @@ using namespace std;
 
 namespace ale {
 
+  // Copy a set of component vectors into column-major storage so that they
+  // can be interpolated together.
+  static vector<double> flattenComponents(const vector<vector<double>> &components) {
+    size_t numSamples = components.empty() ? 0 : components[0].size();
+    vector<double> flattened;
+    flattened.reserve(components.size() * numSamples);
+    for (const vector<double> &component : components) {
+      if (component.size() != numSamples) {
+        throw invalid_argument("Invalid interpolation data, components must be the same size.");
+      }
+      flattened.insert(flattened.end(), component.begin(), component.end());
+    }
+    return flattened;
+  }
+
+  // View column-major component storage
+  static MatrixView componentsView(const vector<double> &components, size_t numComponents) {
+    size_t numSamples = components.size() / numComponents;
+    return MatrixView(components.data(), numComponents, numSamples, numSamples, 1);
+  }
+
+  // Interpolate a set of positions, and their velocities, at many times. All
+  // three axes share one interval search per time and the velocities come
+  // from the same evaluation as the positions. Either output can be null.
+  template <typename Times>
+  static void interpolateStates(const MatrixView &coords, const Times &times,
+                                const double *queryTimes, size_t numQueries,
+                                interpolation interp, double *positions, double *velocities) {
+    if (coords.numComponents() != 3) {
+      throw invalid_argument("Invalid input positions, expected three components.");
+    }
+
+    PiecewisePolynomial::fromInterpolation(times, coords, interp).evaluate(
+          queryTimes, numQueries, positions, velocities);
+  }
+
+  // Throw for a time that an interpolator could not evaluate
+  static void checkStatus(evaluationStatus status) {
+    if (status == outOfRange) {
+      throw invalid_argument("Invalid interpolation time, outside of input times.");
+    }
+  }
+
+  // Interpolate a set of rotations, and their angular velocities, at many
+  // times. Either output can be null.
+  template <typename Times>
+  static void interpolateRotations(const MatrixView &rotations, const Times &times,
+                                   const double *queryTimes, size_t numQueries,
+                                   interpolation interp,
+                                   double *quaternions, double *angularVelocities) {
+    checkStatus(RotationTable(rotations, times, interp).states(queryTimes, numQueries,
+                                                               quaternions, angularVelocities));
+  }
+
   // Position Data Functions
-  vector<double> getPosition(vector<vector<double>> coords, vector<double> times, double time,
-                             interpolation interp) {
+  vector<double> getPosition(const vector<vector<double>>& coords, const vector<double>& times,
+                             double time, interpolation interp) {
     // Check that all of the data sizes are okay
     // TODO is there a cleaner way to do this? We're going to have to do this a lot.
     if (coords.size() != 3) {
       throw invalid_argument("Invalid input positions, expected three vectors.");
     }
 
-    // GSL setup
-    vector<double> coordinate = {0.0, 0.0, 0.0};
-
-    coordinate = { interpolate(coords[0], times, time, interp, 0),
-                   interpolate(coords[1], times, time, interp, 0),
-                   interpolate(coords[2], times, time, interp, 0) };
-
-    return coordinate;
+    vector<double> flattened = flattenComponents(coords);
+    return getPosition(componentsView(flattened, 3), times, time, interp);
   }
 
-  vector<double> getVelocity(vector<vector<double>> coords, vector<double> times,
+  vector<double> getVelocity(const vector<vector<double>>& coords, const vector<double>& times,
                              double time, interpolation interp) {
     // Check that all of the data sizes are okay
     // TODO is there a cleaner way to do this? We're going to have to do this a lot.
@@ -48,14 +95,128 @@ namespace ale {
      throw invalid_argument("Invalid input positions, expected three vectors.");
     }
 
-    // GSL setup
-    vector<double> coordinate = {0.0, 0.0, 0.0};
+    vector<double> flattened = flattenComponents(coords);
+    return getVelocity(componentsView(flattened, 3), times, time, interp);
+  }
 
-    coordinate = { interpolate(coords[0], times, time, interp, 1),
-                   interpolate(coords[1], times, time, interp, 1),
-                   interpolate(coords[2], times, time, interp, 1) };
+  void getPosition(const vector<vector<double>>& coords, const vector<double>& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *positions) {
+    if (coords.size() != 3) {
+      throw invalid_argument("Invalid input positions, expected three vectors.");
+    }
 
-    return coordinate;
+    vector<double> flattened = flattenComponents(coords);
+    interpolateStates(componentsView(flattened, 3), DataView(times), queryTimes, numQueries,
+                      interp, positions, nullptr);
+  }
+
+  void getVelocity(const vector<vector<double>>& coords, const vector<double>& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *velocities) {
+    if (coords.size() != 3) {
+      throw invalid_argument("Invalid input positions, expected three vectors.");
+    }
+
+    vector<double> flattened = flattenComponents(coords);
+    interpolateStates(componentsView(flattened, 3), DataView(times), queryTimes, numQueries,
+                      interp, nullptr, velocities);
+  }
+
+  vector<double> getPosition(const MatrixView& coords, const DataView& times,
+                             double time, interpolation interp) {
+    vector<double> position(3);
+    interpolateStates(coords, times, &time, 1, interp, position.data(), nullptr);
+    return position;
+  }
+
+  vector<double> getVelocity(const MatrixView& coords, const DataView& times,
+                             double time, interpolation interp) {
+    vector<double> velocity(3);
+    interpolateStates(coords, times, &time, 1, interp, nullptr, velocity.data());
+    return velocity;
+  }
+
+  void getPosition(const MatrixView& coords, const DataView& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *positions) {
+    interpolateStates(coords, times, queryTimes, numQueries, interp, positions, nullptr);
+  }
+
+  void getVelocity(const MatrixView& coords, const DataView& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *velocities) {
+    interpolateStates(coords, times, queryTimes, numQueries, interp, nullptr, velocities);
+  }
+
+  vector<double> getPosition(const MatrixView& coords, const UniformTimeGrid& times,
+                             double time, interpolation interp) {
+    vector<double> position(3);
+    interpolateStates(coords, times, &time, 1, interp, position.data(), nullptr);
+    return position;
+  }
+
+  vector<double> getVelocity(const MatrixView& coords, const UniformTimeGrid& times,
+                             double time, interpolation interp) {
+    vector<double> velocity(3);
+    interpolateStates(coords, times, &time, 1, interp, nullptr, velocity.data());
+    return velocity;
+  }
+
+  void getPosition(const MatrixView& coords, const UniformTimeGrid& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *positions) {
+    interpolateStates(coords, times, queryTimes, numQueries, interp, positions, nullptr);
+  }
+
+  void getVelocity(const MatrixView& coords, const UniformTimeGrid& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *velocities) {
+    interpolateStates(coords, times, queryTimes, numQueries, interp, nullptr, velocities);
+  }
+
+  void getState(const MatrixView& coords, const DataView& times,
+                const double *queryTimes, size_t numQueries,
+                interpolation interp, double *positions, double *velocities) {
+    interpolateStates(coords, times, queryTimes, numQueries, interp, positions, velocities);
+  }
+
+  void getState(const MatrixView& coords, const UniformTimeGrid& times,
+                const double *queryTimes, size_t numQueries,
+                interpolation interp, double *positions, double *velocities) {
+    interpolateStates(coords, times, queryTimes, numQueries, interp, positions, velocities);
+  }
+
+  vector<double> getPosition(const StateTable& states, double time, interpolation interp) {
+    vector<double> position(3);
+    checkStatus(StateInterpolator(states, interp).position(time, position.data()));
+    return position;
+  }
+
+  vector<double> getVelocity(const StateTable& states, double time, interpolation interp) {
+    vector<double> velocity(3);
+    checkStatus(StateInterpolator(states, interp).velocity(time, velocity.data()));
+    return velocity;
+  }
+
+  void getPosition(const StateTable& states,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *positions) {
+    checkStatus(StateInterpolator(states, interp).states(queryTimes, numQueries, positions, nullptr));
+  }
+
+  void getVelocity(const StateTable& states,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *velocities) {
+    checkStatus(StateInterpolator(states, interp).states(queryTimes, numQueries,
+                                                         nullptr, velocities));
+  }
+
+  void getState(const StateTable& states,
+                const double *queryTimes, size_t numQueries,
+                interpolation interp, double *positions, double *velocities) {
+    checkStatus(StateInterpolator(states, interp).states(queryTimes, numQueries,
+                                                         positions, velocities));
   }
 
   // Postion Function Functions
@@ -66,7 +227,7 @@ namespace ale {
   //                x = cx_n * t^n + cx_n-1 * t^(n-1) + ... + cx_0
   //                y = cy_n * t^n + cy_n-1 * t^(n-1) + ... + cy_0
   //                z = cz_n * t^n + cz_n-1 * t^(n-1) + ... + cz_0
-  vector<double> getPosition(vector<vector<double>> coeffs, double time) {
+  vector<double> getPosition(const vector<vector<double>>& coeffs, double time) {
 
     if (coeffs.size() != 3) {
       throw invalid_argument("Invalid input coeffs, expected three vectors.");
@@ -83,7 +244,7 @@ namespace ale {
 
   // Velocity Function
   // Takes the coefficients from the position equation
-  vector<double> getVelocity(vector<vector<double>> coeffs, double time) {
+  vector<double> getVelocity(const vector<vector<double>>& coeffs, double time) {
 
     if (coeffs.size() != 3) {
       throw invalid_argument("Invalid input coeffs, expected three vectors.");
@@ -98,83 +259,192 @@ namespace ale {
   }
 
 
+  // Evaluate each of a set of polynomials and their first derivatives at a
+  // set of times, and interleave the results so values[3 * i + j] is
+  // polynomial j at time i. Either output can be null.
+  static void evaluatePolynomials(const vector<vector<double>>& coeffs,
+                                  const double *times, size_t numTimes,
+                                  double *values, double *firstDerivatives) {
+    size_t numPolys = coeffs.size();
+    vector<double> componentValues(values ? numTimes : 0);
+    vector<double> componentDerivatives(firstDerivatives ? numTimes : 0);
+    for (size_t j = 0; j < numPolys; j++) {
+      if (coeffs[j].empty()) {
+        throw invalid_argument("Invalid input coeffs, must be non-empty.");
+      }
+      evaluatePolynomial(coeffs[j].data(), coeffs[j].size(), times, numTimes,
+                         values ? componentValues.data() : nullptr,
+                         firstDerivatives ? componentDerivatives.data() : nullptr);
+      for (size_t i = 0; values && i < numTimes; i++) {
+        values[numPolys * i + j] = componentValues[i];
+      }
+      for (size_t i = 0; firstDerivatives && i < numTimes; i++) {
+        firstDerivatives[numPolys * i + j] = componentDerivatives[i];
+      }
+    }
+  }
+
+  void getPosition(const vector<vector<double>>& coeffs,
+                   const double *times, size_t numTimes, double *positions) {
+    if (coeffs.size() != 3) {
+      throw invalid_argument("Invalid input coeffs, expected three vectors.");
+    }
+
+    evaluatePolynomials(coeffs, times, numTimes, positions, nullptr);
+  }
+
+  void getVelocity(const vector<vector<double>>& coeffs,
+                   const double *times, size_t numTimes, double *velocities) {
+    if (coeffs.size() != 3) {
+      throw invalid_argument("Invalid input coeffs, expected three vectors.");
+    }
+
+    evaluatePolynomials(coeffs, times, numTimes, nullptr, velocities);
+  }
+
+
   // Rotation Data Functions
-  vector<double> getRotation(vector<vector<double>> rotations,
-                             vector<double> times, double time,  interpolation interp) {
+  vector<double> getRotation(const vector<vector<double>>& rotations,
+                             const vector<double>& times, double time,  interpolation interp) {
     // Check that all of the data sizes are okay
     // TODO is there a cleaner way to do this? We're going to have to do this a lot.
     if (rotations.size() != 4) {
      throw invalid_argument("Invalid input rotations, expected four vectors.");
     }
 
-    // Alot of copying and reassignment becuase conflicting data types
-    // probably should rethink our vector situation to guarentee contiguous
-    // memory. Should be easy to switch to a contiguous column-major format
-    // if we stick with Eigen.
-    for (size_t i = 0; i<rotations[0].size(); i++) {
-      Eigen::Quaterniond quat(rotations[0][i], rotations[1][i], rotations[2][i], rotations[3][i]);
-      quat.normalize();
-
-      rotations[0][i] = quat.w();
-      rotations[1][i] = quat.x();
-      rotations[2][i] = quat.y();
-      rotations[3][i] = quat.z();
-    }
-
-    // GSL setup
-    vector<double> coordinate = {0.0, 0.0, 0.0, 0.0};
+    vector<double> flattened = flattenComponents(rotations);
+    return getRotation(componentsView(flattened, 4), times, time, interp);
+  }
 
-    coordinate = { interpolate(rotations[0], times, time, interp, 0),
-                   interpolate(rotations[1], times, time, interp, 0),
-                   interpolate(rotations[2], times, time, interp, 0),
-                   interpolate(rotations[3], times, time, interp, 0)};
+  void getRotation(const vector<vector<double>>& rotations, const vector<double>& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *quaternions) {
+    if (rotations.size() != 4) {
+     throw invalid_argument("Invalid input rotations, expected four vectors.");
+    }
 
-    // Eigen::Map to ensure the array isn't copied, only the pointer is
-    Eigen::Map<Eigen::MatrixXd> quat(coordinate.data(), 4, 1);
-    quat.normalize();
-    return coordinate;
+    vector<double> flattened = flattenComponents(rotations);
+    interpolateRotations(componentsView(flattened, 4), DataView(times), queryTimes, numQueries,
+                         interp, quaternions, nullptr);
   }
 
-  vector<double> getAngularVelocity(vector<vector<double>> rotations,
-                                    vector<double> times, double time,  interpolation interp) {
+  vector<double> getAngularVelocity(const vector<vector<double>>& rotations,
+                                    const vector<double>& times, double time,  interpolation interp) {
     // Check that all of the data sizes are okay
     // TODO is there a cleaner way to do this? We're going to have to do this a lot.
     if (rotations.size() != 4) {
      throw invalid_argument("Invalid input rotations, expected four vectors.");
     }
 
-    double data[] = {0,0,0,0};
-    for (size_t i = 0; i<rotations[0].size(); i++) {
-      Eigen::Quaterniond quat(rotations[0][i], rotations[1][i], rotations[2][i], rotations[3][i]);
-      quat.normalize();
-      rotations[0][i] = quat.w();
-      rotations[1][i] = quat.x();
-      rotations[2][i] = quat.y();
-      rotations[3][i] = quat.z();
-    }
+    vector<double> flattened = flattenComponents(rotations);
+    return getAngularVelocity(componentsView(flattened, 4), times, time, interp);
+  }
 
-    // GSL setup
+  vector<double> getRotation(const MatrixView& rotations, const DataView& times,
+                             double time, interpolation interp) {
+    vector<double> quaternion(4);
+    interpolateRotations(rotations, times, &time, 1, interp, quaternion.data(), nullptr);
+    return quaternion;
+  }
 
+  void getRotation(const MatrixView& rotations, const DataView& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *quaternions) {
+    interpolateRotations(rotations, times, queryTimes, numQueries, interp, quaternions, nullptr);
+  }
 
-    Eigen::Quaterniond quat(interpolate(rotations[0], times, time, interp, 0),
-                            interpolate(rotations[1], times, time, interp, 0),
-                            interpolate(rotations[2], times, time, interp, 0),
-                            interpolate(rotations[3], times, time, interp, 0));
-    quat.normalize();
+  vector<double> getAngularVelocity(const MatrixView& rotations, const DataView& times,
+                                    double time, interpolation interp) {
+    vector<double> angularVelocity(3);
+    interpolateRotations(rotations, times, &time, 1, interp, nullptr, angularVelocity.data());
+    return angularVelocity;
+  }
 
-    Eigen::Quaterniond dQuat(interpolate(rotations[0], times, time, interp, 1),
-                             interpolate(rotations[1], times, time, interp, 1),
-                             interpolate(rotations[2], times, time, interp, 1),
-                             interpolate(rotations[3], times, time, interp, 1));
+  vector<double> getRotation(const MatrixView& rotations, const UniformTimeGrid& times,
+                             double time, interpolation interp) {
+    vector<double> quaternion(4);
+    interpolateRotations(rotations, times, &time, 1, interp, quaternion.data(), nullptr);
+    return quaternion;
+  }
+
+  void getRotation(const MatrixView& rotations, const UniformTimeGrid& times,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *quaternions) {
+    interpolateRotations(rotations, times, queryTimes, numQueries, interp, quaternions, nullptr);
+  }
+
+  vector<double> getAngularVelocity(const MatrixView& rotations, const UniformTimeGrid& times,
+                                    double time, interpolation interp) {
+    vector<double> angularVelocity(3);
+    interpolateRotations(rotations, times, &time, 1, interp, nullptr, angularVelocity.data());
+    return angularVelocity;
+  }
 
-     Eigen::Quaterniond avQuat = quat.conjugate() * dQuat;
+  void getRotationState(const MatrixView& rotations, const DataView& times,
+                        const double *queryTimes, size_t numQueries, interpolation interp,
+                        double *quaternions, double *angularVelocities) {
+    interpolateRotations(rotations, times, queryTimes, numQueries, interp,
+                         quaternions, angularVelocities);
+  }
 
-     vector<double> coordinate = {-2 * avQuat.x(), -2 * avQuat.y(), -2 * avQuat.z()};
-     return coordinate;
+  void getRotationState(const MatrixView& rotations, const UniformTimeGrid& times,
+                        const double *queryTimes, size_t numQueries, interpolation interp,
+                        double *quaternions, double *angularVelocities) {
+    interpolateRotations(rotations, times, queryTimes, numQueries, interp,
+                         quaternions, angularVelocities);
+  }
+
+  vector<double> getRotation(const QuaternionTable& rotations, double time, interpolation interp) {
+    vector<double> quaternion(4);
+    checkStatus(RotationTable(rotations, interp).rotation(time, quaternion.data()));
+    return quaternion;
+  }
+
+  void getRotation(const QuaternionTable& rotations,
+                   const double *queryTimes, size_t numQueries,
+                   interpolation interp, double *quaternions) {
+    checkStatus(RotationTable(rotations, interp).states(queryTimes, numQueries, quaternions, nullptr));
+  }
+
+  vector<double> getAngularVelocity(const QuaternionTable& rotations, double time, interpolation interp) {
+    vector<double> angularVelocity(3);
+    checkStatus(RotationTable(rotations, interp).angularVelocity(time, angularVelocity.data()));
+    return angularVelocity;
+  }
+
+  void getRotationState(const QuaternionTable& rotations,
+                        const double *queryTimes, size_t numQueries, interpolation interp,
+                        double *quaternions, double *angularVelocities) {
+    checkStatus(RotationTable(rotations, interp).states(queryTimes, numQueries,
+                                                        quaternions, angularVelocities));
   }
 
   // Rotation Function Functions
-  std::vector<double> getRotation(vector<vector<double>> coeffs, double time) {
+  // The rotation is the ZXZ Euler rotation with angles, in degrees, given by
+  // the polynomials.
+  static Eigen::Quaterniond eulerRotation(double phi, double theta, double psi) {
+    Eigen::Quaterniond quat;
+    quat = Eigen::AngleAxisd(phi * M_PI / 180, Eigen::Vector3d::UnitZ())
+                * Eigen::AngleAxisd(theta * M_PI / 180, Eigen::Vector3d::UnitX())
+                * Eigen::AngleAxisd(psi * M_PI / 180, Eigen::Vector3d::UnitZ());
+
+    quat.normalize();
+    return quat;
+  }
+
+  static Eigen::Vector3d eulerAngularVelocity(double phi, double theta,
+                                              double phi_dt, double theta_dt, double psi_dt) {
+    Eigen::Quaterniond quat1, quat2;
+    quat1 = Eigen::AngleAxisd(phi * M_PI / 180, Eigen::Vector3d::UnitZ());
+    quat2 =  Eigen::AngleAxisd(theta * M_PI / 180, Eigen::Vector3d::UnitX());
+
+    Eigen::Vector3d velocity =  phi_dt * Eigen::Vector3d::UnitZ();
+    velocity += theta_dt * (quat1 *  Eigen::Vector3d::UnitX());
+    velocity += psi_dt * (quat1 * quat2 *  Eigen::Vector3d::UnitZ());
+    return velocity;
+  }
+
+  std::vector<double> getRotation(const vector<vector<double>>& coeffs, double time) {
 
     if (coeffs.size() != 3) {
       throw invalid_argument("Invalid input coefficients, expected three vectors.");
@@ -186,18 +456,30 @@ namespace ale {
     rotation[1] = evaluatePolynomial(coeffs[1], time, 0); // Y
     rotation[2] = evaluatePolynomial(coeffs[2], time, 0); // Z
 
-    Eigen::Quaterniond quat;
-    quat = Eigen::AngleAxisd(rotation[0] * M_PI / 180, Eigen::Vector3d::UnitZ())
-                * Eigen::AngleAxisd(rotation[1] * M_PI / 180, Eigen::Vector3d::UnitX())
-                * Eigen::AngleAxisd(rotation[2] * M_PI / 180, Eigen::Vector3d::UnitZ());
-
-    quat.normalize();
+    Eigen::Quaterniond quat = eulerRotation(rotation[0], rotation[1], rotation[2]);
 
     vector<double> rotationQ = {quat.w(), quat.x(), quat.y(), quat.z()};
     return rotationQ;
   }
 
-  vector<double> getAngularVelocity(vector<vector<double>> coeffs, double time) {
+  void getRotation(const vector<vector<double>>& coeffs,
+                   const double *times, size_t numTimes, double *quaternions) {
+    if (coeffs.size() != 3) {
+      throw invalid_argument("Invalid input coefficients, expected three vectors.");
+    }
+
+    vector<double> angles(3 * numTimes);
+    evaluatePolynomials(coeffs, times, numTimes, angles.data(), nullptr);
+    for (size_t i = 0; i < numTimes; i++) {
+      Eigen::Quaterniond quat = eulerRotation(angles[3 * i], angles[3 * i + 1], angles[3 * i + 2]);
+      quaternions[4 * i] = quat.w();
+      quaternions[4 * i + 1] = quat.x();
+      quaternions[4 * i + 2] = quat.y();
+      quaternions[4 * i + 3] = quat.z();
+    }
+  }
+
+  vector<double> getAngularVelocity(const vector<vector<double>>& coeffs, double time) {
 
     if (coeffs.size() != 3) {
       throw invalid_argument("Invalid input coefficients, expected three vectors.");
@@ -205,23 +487,34 @@ namespace ale {
 
     double phi = evaluatePolynomial(coeffs[0], time, 0); // X
     double theta = evaluatePolynomial(coeffs[1], time, 0); // Y
-    double psi = evaluatePolynomial(coeffs[2], time, 0); // Z
 
     double phi_dt = evaluatePolynomial(coeffs[0], time, 1);
     double theta_dt = evaluatePolynomial(coeffs[1], time, 1);
     double psi_dt = evaluatePolynomial(coeffs[2], time, 1);
 
-    Eigen::Quaterniond quat1, quat2;
-    quat1 = Eigen::AngleAxisd(phi * M_PI / 180, Eigen::Vector3d::UnitZ());
-    quat2 =  Eigen::AngleAxisd(theta * M_PI / 180, Eigen::Vector3d::UnitX());
-
-    Eigen::Vector3d velocity =  phi_dt * Eigen::Vector3d::UnitZ();
-    velocity += theta_dt * (quat1 *  Eigen::Vector3d::UnitX());
-    velocity += psi_dt * (quat1 * quat2 *  Eigen::Vector3d::UnitZ());
+    Eigen::Vector3d velocity = eulerAngularVelocity(phi, theta, phi_dt, theta_dt, psi_dt);
 
     return {velocity[0], velocity[1], velocity[2]};
   }
 
+  void getAngularVelocity(const vector<vector<double>>& coeffs,
+                          const double *times, size_t numTimes, double *angularVelocities) {
+    if (coeffs.size() != 3) {
+      throw invalid_argument("Invalid input coefficients, expected three vectors.");
+    }
+
+    vector<double> angles(3 * numTimes);
+    vector<double> rates(3 * numTimes);
+    evaluatePolynomials(coeffs, times, numTimes, angles.data(), rates.data());
+    for (size_t i = 0; i < numTimes; i++) {
+      Eigen::Vector3d velocity = eulerAngularVelocity(angles[3 * i], angles[3 * i + 1],
+                                                      rates[3 * i], rates[3 * i + 1], rates[3 * i + 2]);
+      angularVelocities[3 * i] = velocity[0];
+      angularVelocities[3 * i + 1] = velocity[1];
+      angularVelocities[3 * i + 2] = velocity[2];
+    }
+  }
+
   // Polynomial evaluation helper function
   // The equation evaluated by this function is:
   //                x = cx_0 + cx_1 * t^(1) + ... + cx_n * t^n
@@ -230,64 +523,17 @@ namespace ale {
   //   0: no derivative
   //   1: first derivative
   //   2: second derivative
-  double evaluatePolynomial(vector<double> coeffs, double time, int d){
-    if (coeffs.empty()) {
-      throw invalid_argument("Invalid input coeffs, must be non-empty.");
-    }
+  // Polynomials up to degree 10 are dispatched to unrolled kernels.
+  double evaluatePolynomial(const vector<double>& coeffs, double time, int d){
+    return evaluatePolynomial(coeffs.data(), coeffs.size(), time, d);
+  }
 
-    if (d < 0) {
-      throw invalid_argument("Invalid derivative degree, must be non-negative.");
-    }
+ double interpolate(const vector<double>& points, const vector<double>& times, double time, interpolation interp, int d) {
+   return Interpolator(DataView(points), DataView(times), interp).eval(time, d);
+ }
 
-    vector<double> derivatives(d + 1);
-    gsl_poly_eval_derivs(coeffs.data(), coeffs.size(), time,
-                         derivatives.data(), derivatives.size());
-
-    return derivatives.back();
-  }
-
- double interpolate(vector<double> points, vector<double> times, double time, interpolation interp, int d) {
-   size_t numPoints = points.size();
-   if (numPoints < 2) {
-     throw invalid_argument("At least two points must be input to interpolate over.");
-   }
-   if (points.size() != times.size()) {
-     throw invalid_argument("Invalid gsl_interp_type data, must have the same number of points as times.");
-   }
-   if (time < times.front() || time > times.back()) {
-     throw invalid_argument("Invalid gsl_interp_type time, outside of input times.");
-   }
-
-   // convert our interp enum into a GSL one,
-   // should be easy to add non GSL interp methods here later
-   const gsl_interp_type *interp_methods[] = {gsl_interp_linear, gsl_interp_cspline};
-
-   gsl_interp *interpolator = gsl_interp_alloc(interp_methods[interp], numPoints);
-   gsl_interp_init(interpolator, &times[0], &points[0], numPoints);
-   gsl_interp_accel *acc = gsl_interp_accel_alloc();
-
-   // GSL evaluate
-   double result;
-   switch(d) {
-     case 0:
-       result = gsl_interp_eval(interpolator, &times[0], &points[0], time, acc);
-       break;
-     case 1:
-       result = gsl_interp_eval_deriv(interpolator, &times[0], &points[0], time, acc);
-       break;
-     case 2:
-       result = gsl_interp_eval_deriv2(interpolator, &times[0], &points[0], time, acc);
-       break;
-     default:
-       throw invalid_argument("Invalid derivitive option, must be 0, 1 or 2.");
-       break;
-   }
-
-   // GSL clean up
-   gsl_interp_free(interpolator);
-   gsl_interp_accel_free(acc);
-
-   return result;
+ double interpolate(const DataView& points, const DataView& times, double time, interpolation interp, int d) {
+   return Interpolator(points, times, interp).eval(time, d);
  }
 
  std::string getPyTraceback() {
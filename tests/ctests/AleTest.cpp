@@ -39,6 +39,273 @@ TEST(PositionInterpTest, FourCoordinates) {
 }
 
 
+TEST(PositionInterpTest, BatchLinearInterp) {
+  vector<double> times = { -3, -2, -1,  0,  1,  2};
+  vector<vector<double>> data = {{ -3, -2, -1,  0,  1,  2},
+                                 {  9,  4,  1,  0,  1,  4},
+                                 {-27, -8, -1,  0,  1,  8}};
+  vector<double> queryTimes = {-3, -1.5, 0.5, 2};
+  vector<double> positions(3 * queryTimes.size());
+
+  ale::getPosition(data, times, queryTimes.data(), queryTimes.size(), ale::linear, positions.data());
+
+  for (size_t i = 0; i < queryTimes.size(); i++) {
+    vector<double> coordinate = ale::getPosition(data, times, queryTimes[i], ale::linear);
+    EXPECT_DOUBLE_EQ(coordinate[0], positions[3 * i]);
+    EXPECT_DOUBLE_EQ(coordinate[1], positions[3 * i + 1]);
+    EXPECT_DOUBLE_EQ(coordinate[2], positions[3 * i + 2]);
+  }
+}
+
+
+TEST(PositionInterpTest, BatchOutsideTimes) {
+  vector<double> times = { -3, -2, -1,  0,  1,  2};
+  vector<vector<double>> data = {{ -3, -2, -1,  0,  1,  2},
+                                 {  9,  4,  1,  0,  1,  4},
+                                 {-27, -8, -1,  0,  1,  8}};
+  vector<double> queryTimes = {-1, 3};
+  vector<double> positions(3 * queryTimes.size());
+
+  EXPECT_THROW(ale::getPosition(data, times, queryTimes.data(), queryTimes.size(), ale::linear, positions.data()),
+               invalid_argument);
+}
+
+
+TEST(VelocityInterpTest, BatchSplineInterp) {
+  vector<double> times = { -3, -2, -1,  0,  1,  2};
+  vector<vector<double>> data = {{ -3, -2, -1,  0,  1,  2},
+                                 {  9,  4,  1,  0,  1,  4},
+                                 {-27, -8, -1,  0,  1,  8}};
+  vector<double> queryTimes = {-2.5, -0.5, 0.0, 1.5};
+  vector<double> velocities(3 * queryTimes.size());
+
+  ale::getVelocity(data, times, queryTimes.data(), queryTimes.size(), ale::spline, velocities.data());
+
+  for (size_t i = 0; i < queryTimes.size(); i++) {
+    vector<double> velocity = ale::getVelocity(data, times, queryTimes[i], ale::spline);
+    EXPECT_DOUBLE_EQ(velocity[0], velocities[3 * i]);
+    EXPECT_DOUBLE_EQ(velocity[1], velocities[3 * i + 1]);
+    EXPECT_DOUBLE_EQ(velocity[2], velocities[3 * i + 2]);
+  }
+}
+
+
+TEST(PositionInterpTest, RowMajorView) {
+  vector<double> times = { -3, -2, -1,  0,  1,  2};
+  // (n, 3) row-major like a numpy array of positions
+  vector<double> data = { -3,  9, -27,
+                          -2,  4,  -8,
+                          -1,  1,  -1,
+                           0,  0,   0,
+                           1,  1,   1,
+                           2,  4,   8};
+  ale::MatrixView coords(data.data(), 3, times.size(), 1, 3);
+
+  vector<double> coordinate = ale::getPosition(coords, times, -1.5, ale::linear);
+  ASSERT_EQ(3, coordinate.size());
+  EXPECT_DOUBLE_EQ(-1.5, coordinate[0]);
+  EXPECT_DOUBLE_EQ(2.5,  coordinate[1]);
+  EXPECT_DOUBLE_EQ(-4.5, coordinate[2]);
+
+  vector<double> velocity = ale::getVelocity(coords, times, -1.5, ale::linear);
+  ASSERT_EQ(3, velocity.size());
+  EXPECT_DOUBLE_EQ(1.0,  velocity[0]);
+  EXPECT_DOUBLE_EQ(-3.0, velocity[1]);
+  EXPECT_DOUBLE_EQ(7.0,  velocity[2]);
+}
+
+
+TEST(PositionInterpTest, ColumnMajorView) {
+  vector<double> times = { -3, -2, -1,  0,  1,  2};
+  vector<vector<double>> data = {{ -3, -2, -1,  0,  1,  2},
+                                 {  9,  4,  1,  0,  1,  4},
+                                 {-27, -8, -1,  0,  1,  8}};
+  vector<double> flatData = { -3, -2, -1,  0,  1,  2,
+                               9,  4,  1,  0,  1,  4,
+                             -27, -8, -1,  0,  1,  8};
+  ale::MatrixView coords(flatData.data(), 3, times.size(), times.size(), 1);
+  vector<double> queryTimes = {-2.5, -0.5, 0.0, 1.5};
+  vector<double> positions(3 * queryTimes.size());
+  vector<double> expected(3 * queryTimes.size());
+
+  ale::getPosition(coords, times, queryTimes.data(), queryTimes.size(), ale::spline, positions.data());
+  ale::getPosition(data, times, queryTimes.data(), queryTimes.size(), ale::spline, expected.data());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_DOUBLE_EQ(expected[i], positions[i]);
+  }
+}
+
+
+TEST(PositionInterpTest, ViewTwoComponents) {
+  vector<double> times = {0, 1};
+  vector<double> data = {0, 1, 2, 3};
+  ale::MatrixView coords(data.data(), 2, times.size(), 2, 1);
+
+  EXPECT_THROW(ale::getPosition(coords, times, 0.5, ale::linear), invalid_argument);
+}
+
+
+TEST(PositionInterpTest, StateTable) {
+  vector<double> times = { -3, -2, -1,  0,  1,  2};
+  vector<vector<double>> data = {{ -3, -2, -1,  0,  1,  2},
+                                 {  9,  4,  1,  0,  1,  4},
+                                 {-27, -8, -1,  0,  1,  8}};
+  ale::StateTable states(times, data);
+
+  vector<double> coordinate = ale::getPosition(states, -1.5, ale::linear);
+  ASSERT_EQ(3, coordinate.size());
+  EXPECT_DOUBLE_EQ(-1.5, coordinate[0]);
+  EXPECT_DOUBLE_EQ(2.5,  coordinate[1]);
+  EXPECT_DOUBLE_EQ(-4.5, coordinate[2]);
+
+  vector<double> queryTimes = {-2.5, 0.5};
+  vector<double> velocities(3 * queryTimes.size());
+  ale::getVelocity(states, queryTimes.data(), queryTimes.size(), ale::spline, velocities.data());
+  for (size_t i = 0; i < queryTimes.size(); i++) {
+    vector<double> velocity = ale::getVelocity(data, times, queryTimes[i], ale::spline);
+    EXPECT_DOUBLE_EQ(velocity[0], velocities[3 * i]);
+    EXPECT_DOUBLE_EQ(velocity[1], velocities[3 * i + 1]);
+    EXPECT_DOUBLE_EQ(velocity[2], velocities[3 * i + 2]);
+  }
+}
+
+
+TEST(PositionInterpTest, HermiteStateTable) {
+  // x = t^3, y = t^2, z = t
+  vector<double> times = { -2, -1,  0,  1,  2};
+  vector<vector<double>> positions = {{-8, -1,  0,  1,  8},
+                                      { 4,  1,  0,  1,  4},
+                                      {-2, -1,  0,  1,  2}};
+  vector<vector<double>> velocities = {{12,  3,  0,  3, 12},
+                                       {-4, -2,  0,  2,  4},
+                                       { 1,  1,  1,  1,  1}};
+  ale::StateTable states(times, positions, velocities);
+
+  vector<double> position = ale::getPosition(states, -1.5, ale::hermite);
+  ASSERT_EQ(3, position.size());
+  EXPECT_NEAR(-3.375, position[0], 1e-12);
+  EXPECT_NEAR(2.25, position[1], 1e-12);
+  EXPECT_NEAR(-1.5, position[2], 1e-12);
+
+  vector<double> velocity = ale::getVelocity(states, 0.5, ale::hermite);
+  ASSERT_EQ(3, velocity.size());
+  EXPECT_NEAR(0.75, velocity[0], 1e-12);
+  EXPECT_NEAR(1.0, velocity[1], 1e-12);
+  EXPECT_NEAR(1.0, velocity[2], 1e-12);
+
+  vector<double> queryTimes = {-0.5, 1.5};
+  vector<double> batchPositions(3 * queryTimes.size());
+  vector<double> batchVelocities(3 * queryTimes.size());
+  ale::getState(states, queryTimes.data(), queryTimes.size(), ale::hermite,
+                batchPositions.data(), batchVelocities.data());
+  for (size_t i = 0; i < queryTimes.size(); i++) {
+    double t = queryTimes[i];
+    EXPECT_NEAR(t * t * t, batchPositions[3 * i], 1e-12);
+    EXPECT_NEAR(t * t, batchPositions[3 * i + 1], 1e-12);
+    EXPECT_NEAR(t, batchPositions[3 * i + 2], 1e-12);
+    EXPECT_NEAR(3 * t * t, batchVelocities[3 * i], 1e-12);
+    EXPECT_NEAR(2 * t, batchVelocities[3 * i + 1], 1e-12);
+    EXPECT_NEAR(1.0, batchVelocities[3 * i + 2], 1e-12);
+  }
+
+  vector<double> onlyVelocities(3 * queryTimes.size());
+  ale::getVelocity(states, queryTimes.data(), queryTimes.size(), ale::hermite, onlyVelocities.data());
+  EXPECT_EQ(batchVelocities, onlyVelocities);
+}
+
+TEST(PositionInterpTest, UniformTimeGrid) {
+  ale::UniformTimeGrid grid(-3, 1, 9);
+  vector<double> times = { -3, -2, -1,  0,  1,  2,  3,  4,  5};
+  vector<vector<double>> data = {{ -3, -2, -1,  0,  1,  2,  3,  4,  5},
+                                 {  9,  4,  1,  0,  1,  4,  9, 16, 25},
+                                 {-27, -8, -1,  0,  1,  8, 27, 64, 125}};
+  ale::StateTable states(grid, data);
+  ASSERT_TRUE(states.isUniform());
+
+  vector<double> queryTimes = {-2.5, -0.25, 0.5, 4.75};
+  for (ale::interpolation interp : {ale::linear, ale::spline, ale::lagrange}) {
+    vector<double> positions(3 * queryTimes.size());
+    vector<double> velocities(3 * queryTimes.size());
+    ale::getState(states, queryTimes.data(), queryTimes.size(), interp,
+                  positions.data(), velocities.data());
+    for (size_t i = 0; i < queryTimes.size(); i++) {
+      vector<double> position = ale::getPosition(data, times, queryTimes[i], interp);
+      vector<double> velocity = ale::getVelocity(data, times, queryTimes[i], interp);
+      vector<double> gridPosition = ale::getPosition(states, queryTimes[i], interp);
+      for (size_t axis = 0; axis < 3; axis++) {
+        EXPECT_NEAR(position[axis], positions[3 * i + axis], 1e-10);
+        EXPECT_NEAR(velocity[axis], velocities[3 * i + axis], 1e-10);
+        EXPECT_NEAR(position[axis], gridPosition[axis], 1e-10);
+      }
+    }
+  }
+}
+
+
+TEST(PositionInterpTest, ViewGetState) {
+  vector<double> times = { -3, -2, -1,  0,  1,  2};
+  vector<vector<double>> data = {{ -3, -2, -1,  0,  1,  2},
+                                 {  9,  4,  1,  0,  1,  4},
+                                 {-27, -8, -1,  0,  1,  8}};
+  vector<double> flatData = { -3, -2, -1,  0,  1,  2,
+                               9,  4,  1,  0,  1,  4,
+                             -27, -8, -1,  0,  1,  8};
+  ale::MatrixView coords(flatData.data(), 3, times.size(), times.size(), 1);
+
+  vector<double> queryTimes = {-2.5, -0.5, 1.75};
+  vector<double> positions(3 * queryTimes.size());
+  vector<double> velocities(3 * queryTimes.size());
+  ale::getState(coords, times, queryTimes.data(), queryTimes.size(), ale::spline,
+                positions.data(), velocities.data());
+  for (size_t i = 0; i < queryTimes.size(); i++) {
+    vector<double> position = ale::getPosition(data, times, queryTimes[i], ale::spline);
+    vector<double> velocity = ale::getVelocity(data, times, queryTimes[i], ale::spline);
+    for (size_t axis = 0; axis < 3; axis++) {
+      EXPECT_DOUBLE_EQ(position[axis], positions[3 * i + axis]);
+      EXPECT_DOUBLE_EQ(velocity[axis], velocities[3 * i + axis]);
+    }
+  }
+
+  // Either output can be skipped
+  ale::getState(coords, times, queryTimes.data(), queryTimes.size(), ale::linear,
+                nullptr, velocities.data());
+  EXPECT_DOUBLE_EQ(1.0, velocities[0]);
+  EXPECT_DOUBLE_EQ(-5.0, velocities[1]);
+  EXPECT_DOUBLE_EQ(19.0, velocities[2]);
+}
+
+
+TEST(PositionInterpTest, HermiteWithoutVelocities) {
+  vector<double> times = {0, 1, 2};
+  vector<vector<double>> data = {{0, 1, 2},
+                                 {0, 1, 2},
+                                 {0, 1, 2}};
+  ale::StateTable states(times, data);
+  EXPECT_THROW(ale::getPosition(states, 0.5, ale::hermite), invalid_argument);
+  EXPECT_THROW(ale::getPosition(data, times, 0.5, ale::hermite), invalid_argument);
+}
+
+
+TEST(PositionInterpTest, LagrangeInterp) {
+  vector<double> times = { -3, -2, -1,  0,  1,  2,  3,  4,  5};
+  vector<vector<double>> data = {{ -3, -2, -1,  0,  1,  2,  3,  4,  5},
+                                 {  9,  4,  1,  0,  1,  4,  9, 16, 25},
+                                 {-27, -8, -1,  0,  1,  8, 27, 64, 125}};
+
+  vector<double> coordinate = ale::getPosition(data, times, 0.5, ale::lagrange);
+  ASSERT_EQ(3, coordinate.size());
+  EXPECT_NEAR(0.5,   coordinate[0], 1e-12);
+  EXPECT_NEAR(0.25,  coordinate[1], 1e-12);
+  EXPECT_NEAR(0.125, coordinate[2], 1e-12);
+
+  vector<double> velocity = ale::getVelocity(data, times, 0.5, ale::lagrange);
+  ASSERT_EQ(3, velocity.size());
+  EXPECT_NEAR(1.0,  velocity[0], 1e-12);
+  EXPECT_NEAR(1.0,  velocity[1], 1e-12);
+  EXPECT_NEAR(0.75, velocity[2], 1e-12);
+}
+
+
 TEST(LinearInterpTest, ExampleInterpolation) {
   vector<double> times = {0,  1,  2, 3};
   vector<double> data = {0, 2, 1, 0};
@@ -82,6 +349,17 @@ TEST(LinearInterpTest, Extrapolate) {
 }
 
 
+TEST(LinearInterpTest, StridedView) {
+  vector<double> times = {0,  1,  2, 3};
+  vector<double> data = {0, -1, 2, -1, 1, -1, 0, -1};
+  ale::DataView points(data.data(), 4, 2);
+
+  EXPECT_DOUBLE_EQ(1.0, ale::interpolate(points, times, 0.5, ale::linear, 0));
+  EXPECT_DOUBLE_EQ(1.5, ale::interpolate(points, times, 1.5, ale::linear, 0));
+  EXPECT_DOUBLE_EQ(-1.0, ale::interpolate(points, times, 2.5, ale::linear, 1));
+}
+
+
 TEST(SplineInterpTest, ExampleInterpolation) {
   // From http://www.maths.nuigalway.ie/~niall/teaching/Archive/1617/MA378/2-2-CubicSplines.pdf
   vector<double> times = {0,  1,  2, 3};
@@ -158,6 +436,73 @@ TEST(PolynomialTest, BadDerivative) {
   EXPECT_THROW(ale::evaluatePolynomial(coeffs, -1, -1), invalid_argument);
 }
 
+TEST(PolynomialTest, HighDerivative) {
+  vector<double> coeffs = {1.0, 2.0, 3.0, 4.0}; // 1 + 2x + 3x^2 + 4x^3
+  EXPECT_EQ(24.0, ale::evaluatePolynomial(coeffs, -1, 3));
+  EXPECT_EQ(0.0, ale::evaluatePolynomial(coeffs, -1, 4));
+}
+
+TEST(PolynomialTest, CompileTimeDegree) {
+  static constexpr double coeffs[] = {1.0, 2.0, 3.0}; // 1 + 2x + 3x^2
+  static_assert(ale::evaluatePolynomial<2, 0>(coeffs, -1.0) == 2.0, "value");
+  static_assert(ale::evaluatePolynomial<2, 1>(coeffs, -1.0) == -4.0, "first derivative");
+  static_assert(ale::evaluatePolynomial<2, 2>(coeffs, -1.0) == 6.0, "second derivative");
+  static_assert(ale::evaluatePolynomial<2, 3>(coeffs, -1.0) == 0.0, "third derivative");
+  EXPECT_EQ(17.0, (ale::evaluatePolynomial<2, 0>(coeffs, 2.0)));
+}
+
+TEST(PolynomialTest, DispatchMatchesLoop) {
+  // Cover every unrolled degree and the loop past it
+  vector<double> coeffs;
+  for (int degree = 0; degree <= 12; degree++) {
+    coeffs.push_back(0.5 * degree - 1.0);
+    for (int d = 0; d <= 3; d++) {
+      for (double time : {-1.5, 0.0, 0.75}) {
+        double expected = 0;
+        for (int k = d; k <= degree; k++) {
+          double factor = 1;
+          for (int j = 0; j < d; j++) {
+            factor *= k - j;
+          }
+          expected += coeffs[k] * factor * pow(time, k - d);
+        }
+        EXPECT_NEAR(expected, ale::evaluatePolynomial(coeffs, time, d), 1e-9)
+            << "degree " << degree << " derivative " << d << " time " << time;
+      }
+    }
+  }
+}
+
+TEST(PolynomialTest, BatchEvaluate) {
+  vector<double> coeffs = {1.0, -2.0, 0.5, 3.0, -0.25, 0.125};
+  // An odd number of times so the vectorized and scalar loops are both used
+  vector<double> times;
+  for (int i = 0; i < 19; i++) {
+    times.push_back(-2.0 + 0.23 * i);
+  }
+  vector<double> values(times.size());
+  vector<double> firstDerivatives(times.size());
+  vector<double> secondDerivatives(times.size());
+  ale::evaluatePolynomial(coeffs.data(), coeffs.size(), times.data(), times.size(),
+                          values.data(), firstDerivatives.data(), secondDerivatives.data());
+  for (size_t i = 0; i < times.size(); i++) {
+    EXPECT_NEAR(ale::evaluatePolynomial(coeffs, times[i], 0), values[i], 1e-12);
+    EXPECT_NEAR(ale::evaluatePolynomial(coeffs, times[i], 1), firstDerivatives[i], 1e-12);
+    EXPECT_NEAR(ale::evaluatePolynomial(coeffs, times[i], 2), secondDerivatives[i], 1e-12);
+  }
+
+  // Only the requested outputs are written
+  vector<double> constant = {4.0};
+  ale::evaluatePolynomial(constant.data(), constant.size(), times.data(), times.size(),
+                          nullptr, nullptr, secondDerivatives.data());
+  for (size_t i = 0; i < times.size(); i++) {
+    EXPECT_EQ(0.0, secondDerivatives[i]);
+  }
+
+  EXPECT_THROW(ale::evaluatePolynomial(coeffs.data(), 0, times.data(), times.size(), values.data()),
+               invalid_argument);
+}
+
 
 TEST(PoisitionCoeffTest, SecondOrderPolynomial) {
   double time = 2.0;
@@ -213,6 +558,32 @@ TEST(PoisitionCoeffTest, InvalidInput) {
 }
 
 
+TEST(PoisitionCoeffTest, BatchPositions) {
+  vector<vector<double>> coeffs = {{1.0, 2.0, 3.0},
+                                   {1.0, 3.0, 2.0},
+                                   {3.0, 2.0, 1.0, 0.5}};
+  vector<double> times = {-1.0, 0.0, 0.5, 2.0, 3.0};
+
+  vector<double> positions(3 * times.size());
+  ale::getPosition(coeffs, times.data(), times.size(), positions.data());
+  vector<double> velocities(3 * times.size());
+  ale::getVelocity(coeffs, times.data(), times.size(), velocities.data());
+  for (size_t i = 0; i < times.size(); i++) {
+    vector<double> position = ale::getPosition(coeffs, times[i]);
+    vector<double> velocity = ale::getVelocity(coeffs, times[i]);
+    for (size_t j = 0; j < 3; j++) {
+      EXPECT_NEAR(position[j], positions[3 * i + j], 1e-12);
+      EXPECT_NEAR(velocity[j], velocities[3 * i + j], 1e-12);
+    }
+  }
+
+  EXPECT_THROW(ale::getPosition({{1.0}, {1.0}}, times.data(), times.size(), positions.data()),
+               invalid_argument);
+  EXPECT_THROW(ale::getVelocity({{1.0}, {}, {1.0}}, times.data(), times.size(), velocities.data()),
+               invalid_argument);
+}
+
+
 TEST(VelocityCoeffTest, SecondOrderPolynomial) {
   double time = 2.0;
   vector<vector<double>> coeffs = {{1.0, 2.0, 3.0},
@@ -271,6 +642,31 @@ TEST(AngularVelocityCoeffTest, DefaultAngularExample) {
   EXPECT_DOUBLE_EQ(90, av[2]);
 }
 
+TEST(RotationCoeffTest, BatchRotations) {
+  vector<vector<double>> coeffs = {{10, 90}, {-5, 45}, {0, 30, 2}};
+  vector<double> times = {0.0, 0.25, 0.5, 1.0, 1.5};
+
+  vector<double> quaternions(4 * times.size());
+  ale::getRotation(coeffs, times.data(), times.size(), quaternions.data());
+  vector<double> angularVelocities(3 * times.size());
+  ale::getAngularVelocity(coeffs, times.data(), times.size(), angularVelocities.data());
+  for (size_t i = 0; i < times.size(); i++) {
+    vector<double> quaternion = ale::getRotation(coeffs, times[i]);
+    vector<double> av = ale::getAngularVelocity(coeffs, times[i]);
+    for (size_t j = 0; j < 4; j++) {
+      EXPECT_NEAR(quaternion[j], quaternions[4 * i + j], 1e-12);
+    }
+    for (size_t j = 0; j < 3; j++) {
+      EXPECT_NEAR(av[j], angularVelocities[3 * i + j], 1e-12);
+    }
+  }
+
+  EXPECT_THROW(ale::getRotation({{90}, {0}}, times.data(), times.size(), quaternions.data()),
+               invalid_argument);
+  EXPECT_THROW(ale::getAngularVelocity({{90}, {0}}, times.data(), times.size(), angularVelocities.data()),
+               invalid_argument);
+}
+
 TEST(AngularVelocityCoeffTest, InvalidInput) {
   vector<vector<double>> coeffs = {{0, 90}, {0, 90}};
   double time = 2.0;
@@ -290,6 +686,120 @@ TEST(RotationInterpTest, ExampleGetRotation) {
 }
 
 
+TEST(RotationInterpTest, BatchGetRotation) {
+  vector<double> times = {0,  1,  2, 3};
+  vector<vector<double>> rots({{1, 1, 0, 0}, {0, 0, 1, 1}, {1, 1, 0, 0}, {0, 0, 1, 1}});
+  vector<double> queryTimes = {0.5, 1.5, 2.5};
+  vector<double> quats(4 * queryTimes.size());
+
+  ale::getRotation(rots, times, queryTimes.data(), queryTimes.size(), ale::linear, quats.data());
+
+  for (size_t i = 0; i < queryTimes.size(); i++) {
+    vector<double> quat = ale::getRotation(rots, times, queryTimes[i], ale::linear);
+    EXPECT_DOUBLE_EQ(quat[0], quats[4 * i]);
+    EXPECT_DOUBLE_EQ(quat[1], quats[4 * i + 1]);
+    EXPECT_DOUBLE_EQ(quat[2], quats[4 * i + 2]);
+    EXPECT_DOUBLE_EQ(quat[3], quats[4 * i + 3]);
+  }
+}
+
+
+TEST(RotationInterpTest, ViewGetRotation) {
+  vector<double> times = {0,  1,  2, 3};
+  vector<vector<double>> rots({{1, 1, 0, 0}, {0, 0, 1, 1}, {1, 1, 0, 0}, {0, 0, 1, 1}});
+  // (n, 4) row-major w, x, y, z quaternions
+  vector<double> flatRots = {1, 0, 1, 0,
+                             1, 0, 1, 0,
+                             0, 1, 0, 1,
+                             0, 1, 0, 1};
+  ale::MatrixView rotView(flatRots.data(), 4, times.size(), 1, 4);
+
+  vector<double> quat = ale::getRotation(rotView, times, 1.5, ale::linear);
+  vector<double> expectedQuat = ale::getRotation(rots, times, 1.5, ale::linear);
+  ASSERT_EQ(4, quat.size());
+  for (size_t i = 0; i < 4; i++) {
+    EXPECT_DOUBLE_EQ(expectedQuat[i], quat[i]);
+  }
+
+  vector<double> av = ale::getAngularVelocity(rotView, times, 1.5, ale::linear);
+  vector<double> expectedAv = ale::getAngularVelocity(rots, times, 1.5, ale::linear);
+  ASSERT_EQ(3, av.size());
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_DOUBLE_EQ(expectedAv[i], av[i]);
+  }
+}
+
+
+TEST(RotationInterpTest, QuaternionTable) {
+  vector<double> times = {0,  1,  2, 3};
+  vector<vector<double>> rots({{1, 1, 0, 0}, {0, 0, 1, 1}, {1, 1, 0, 0}, {0, 0, 1, 1}});
+  ale::QuaternionTable table(times, rots);
+
+  vector<double> quat = ale::getRotation(table, 1.5, ale::linear);
+  vector<double> expectedQuat = ale::getRotation(rots, times, 1.5, ale::linear);
+  ASSERT_EQ(4, quat.size());
+  for (size_t i = 0; i < 4; i++) {
+    EXPECT_DOUBLE_EQ(expectedQuat[i], quat[i]);
+  }
+
+  vector<double> av = ale::getAngularVelocity(table, 1.5, ale::linear);
+  vector<double> expectedAv = ale::getAngularVelocity(rots, times, 1.5, ale::linear);
+  ASSERT_EQ(3, av.size());
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_DOUBLE_EQ(expectedAv[i], av[i]);
+  }
+}
+
+
+TEST(RotationInterpTest, UniformTimeGrid) {
+  vector<double> times = {0,  1,  2, 3};
+  vector<vector<double>> rots({{1, 1, 0, 0}, {0, 0, 1, 1}, {1, 1, 0, 0}, {0, 0, 1, 1}});
+  ale::QuaternionTable table(ale::UniformTimeGrid(0, 1, 4), rots);
+
+  vector<double> queryTimes = {0.5, 1.5, 3.0};
+  vector<double> quats(4 * queryTimes.size());
+  ale::getRotation(table, queryTimes.data(), queryTimes.size(), ale::linear, quats.data());
+  for (size_t i = 0; i < queryTimes.size(); i++) {
+    vector<double> expectedQuat = ale::getRotation(rots, times, queryTimes[i], ale::linear);
+    vector<double> quat = ale::getRotation(table, queryTimes[i], ale::linear);
+    for (size_t j = 0; j < 4; j++) {
+      EXPECT_NEAR(expectedQuat[j], quats[4 * i + j], 1e-12);
+      EXPECT_NEAR(expectedQuat[j], quat[j], 1e-12);
+    }
+  }
+
+  vector<double> av = ale::getAngularVelocity(table, 1.5, ale::linear);
+  vector<double> expectedAv = ale::getAngularVelocity(rots, times, 1.5, ale::linear);
+  ASSERT_EQ(3, av.size());
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_NEAR(expectedAv[i], av[i], 1e-12);
+  }
+}
+
+
+TEST(RotationInterpTest, RotationState) {
+  vector<double> times = {0,  1,  2, 3};
+  vector<vector<double>> rots({{1, 1, 0, 0}, {0, 0, 1, 1}, {1, 1, 0, 0}, {0, 0, 1, 1}});
+  ale::QuaternionTable table(times, rots);
+
+  vector<double> queryTimes = {0.25, 1.5, 2.75};
+  vector<double> quats(4 * queryTimes.size());
+  vector<double> avs(3 * queryTimes.size());
+  ale::getRotationState(table, queryTimes.data(), queryTimes.size(), ale::spline,
+                        quats.data(), avs.data());
+  for (size_t i = 0; i < queryTimes.size(); i++) {
+    vector<double> quat = ale::getRotation(rots, times, queryTimes[i], ale::spline);
+    vector<double> av = ale::getAngularVelocity(rots, times, queryTimes[i], ale::spline);
+    for (size_t j = 0; j < 4; j++) {
+      EXPECT_DOUBLE_EQ(quat[j], quats[4 * i + j]);
+    }
+    for (size_t j = 0; j < 3; j++) {
+      EXPECT_DOUBLE_EQ(av[j], avs[3 * i + j]);
+    }
+  }
+}
+
+
 TEST(RotationInterpTest, GetRotationDifferentCounts) {
   // incorrect params
   vector<double> times = {0, 1, 2};
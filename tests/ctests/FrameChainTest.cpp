@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+
+#include "FrameChain.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace ale;
+
+static const double halfRoot2 = sqrt(0.5);
+
+// 1 -> 2 is a quarter turn about Z, 2 -> 3 turns about X from 90 to 180
+// degrees, and 3 -> 4 and 4 -> 5 are constant quarter turns about Y
+class FrameChainTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+      chain.addRotation(1, 2, Rotation(halfRoot2, 0, 0, halfRoot2));
+      chain.addRotation(2, 3, TimeDependentRotation({halfRoot2, halfRoot2, 0, 0, 0, 1, 0, 0}, {0, 1},
+                                                    {M_PI / 2, 0, 0, M_PI / 2, 0, 0}));
+      chain.addRotation(3, 4, Rotation(halfRoot2, 0, halfRoot2, 0));
+      chain.addRotation(4, 5, Rotation(halfRoot2, 0, halfRoot2, 0));
+    }
+
+    FrameChain chain;
+};
+
+TEST_F(FrameChainTest, FramePath) {
+  EXPECT_EQ(chain.framePath(1, 5), vector<int>({1, 2, 3, 4, 5}));
+  EXPECT_EQ(chain.framePath(4, 2), vector<int>({4, 3, 2}));
+  EXPECT_THROW(chain.framePath(1, 6), invalid_argument);
+
+  chain.addRotation(6, 7, Rotation());
+  EXPECT_THROW(chain.framePath(1, 6), invalid_argument);
+}
+
+TEST_F(FrameChainTest, ConstantRotation) {
+  const FrameRotation &rotation = chain.rotation(3, 5);
+  ASSERT_FALSE(rotation.isTimeDependent());
+  vector<double> rotated = rotation.constantRotation()({1, 0, 0});
+  EXPECT_NEAR(-1, rotated[0], 1e-12);
+  EXPECT_NEAR(0, rotated[1], 1e-12);
+  EXPECT_NEAR(0, rotated[2], 1e-12);
+
+  const FrameRotation &identity = chain.rotation(2, 2);
+  ASSERT_FALSE(identity.isTimeDependent());
+  EXPECT_NEAR(1, identity.constantRotation().toQuaternion()[0], 1e-12);
+}
+
+TEST_F(FrameChainTest, TimeDependentRotation) {
+  const FrameRotation &rotation = chain.rotation(1, 5);
+  ASSERT_TRUE(rotation.isTimeDependent());
+
+  // The same rotation chained one step at a time
+  FrameRotation expected = chain.rotation(4, 5) * chain.rotation(3, 4) *
+                           chain.rotation(2, 3) * chain.rotation(1, 2);
+  const TimeDependentRotation &chained = rotation.timeDependentRotation();
+  const TimeDependentRotation &stepwise = expected.timeDependentRotation();
+  ASSERT_EQ(chained.times(), stepwise.times());
+  for (size_t i = 0; i < chained.quaternions().size(); i++) {
+    EXPECT_NEAR(stepwise.quaternions()[i], chained.quaternions()[i], 1e-12);
+  }
+  for (size_t i = 0; i < chained.angularVelocities().size(); i++) {
+    EXPECT_NEAR(stepwise.angularVelocities()[i], chained.angularVelocities()[i], 1e-12);
+  }
+
+  // The inverse direction undoes it
+  const TimeDependentRotation &inverse = chain.rotation(5, 1).timeDependentRotation();
+  vector<double> position = {1, 2, 3};
+  vector<double> times = {0.5};
+  chained.apply(position.data(), times.data(), 1, position.data());
+  inverse.apply(position.data(), times.data(), 1, position.data());
+  EXPECT_NEAR(1, position[0], 1e-12);
+  EXPECT_NEAR(2, position[1], 1e-12);
+  EXPECT_NEAR(3, position[2], 1e-12);
+}
+
+TEST_F(FrameChainTest, Memoized) {
+  const FrameRotation &first = chain.rotation(1, 5);
+  const FrameRotation &second = chain.rotation(1, 5);
+  EXPECT_EQ(&first, &second);
+  EXPECT_EQ(&first.timeDependentRotation(), &second.timeDependentRotation());
+
+  // Adding a rotation can change the path, so the chained rotations are recomputed
+  chain.addRotation(1, 5, Rotation());
+  const FrameRotation &shortcut = chain.rotation(1, 5);
+  EXPECT_FALSE(shortcut.isTimeDependent());
+}
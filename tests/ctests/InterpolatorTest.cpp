@@ -0,0 +1,217 @@
+#include "gtest/gtest.h"
+
+#include "Interpolator.h"
+
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+using namespace ale;
+
+TEST(InterpolatorTest, LinearEvaluate) {
+  vector<double> times = {0,  1,  2, 3};
+  vector<double> data = {0, 2, 1, 0};
+  Interpolator interp(data, times, linear);
+
+  ASSERT_EQ(interp.size(), 4);
+  EXPECT_DOUBLE_EQ(0.0, interp.eval(0.0));
+  EXPECT_DOUBLE_EQ(1.0, interp.eval(0.5));
+  EXPECT_DOUBLE_EQ(1.5, interp.eval(1.5));
+  EXPECT_DOUBLE_EQ(0.0, interp.eval(3.0));
+  EXPECT_DOUBLE_EQ(2.0, interp.eval(0.5, 1));
+  EXPECT_DOUBLE_EQ(-1.0, interp.eval(2.5, 1));
+}
+
+TEST(InterpolatorTest, RepeatedEvaluate) {
+  vector<double> times = {0,  1,  2, 3};
+  vector<double> data = {0, 2, 1, 0};
+  Interpolator interp(data, times, spline);
+
+  // Evaluating out of order should not depend on the cached interval
+  double tolerance = 1e-10;
+  EXPECT_NEAR(3.375 - 5.4 * 2.25 + 8.2 * 1.5 - 1.8, interp.eval(1.5), tolerance);
+  EXPECT_NEAR(2.8 * 0.5 - 0.8 * 0.125, interp.eval(0.5), tolerance);
+  EXPECT_NEAR(-0.2 * 15.625 + 1.8 * 6.25 - 6.2 * 2.5 + 7.8, interp.eval(2.5), tolerance);
+  EXPECT_NEAR(3.375 - 5.4 * 2.25 + 8.2 * 1.5 - 1.8, interp.eval(1.5), tolerance);
+}
+
+TEST(InterpolatorTest, BatchEvaluate) {
+  vector<double> times = {0,  1,  2, 3};
+  vector<double> data = {0, 2, 1, 0};
+  Interpolator interp(data, times, linear);
+  vector<double> queryTimes = {0.0, 0.5, 1.5, 2.5, 3.0};
+  vector<double> values(queryTimes.size());
+
+  interp.eval(queryTimes.data(), queryTimes.size(), 0, values.data());
+  EXPECT_DOUBLE_EQ(0.0, values[0]);
+  EXPECT_DOUBLE_EQ(1.0, values[1]);
+  EXPECT_DOUBLE_EQ(1.5, values[2]);
+  EXPECT_DOUBLE_EQ(0.5, values[3]);
+  EXPECT_DOUBLE_EQ(0.0, values[4]);
+
+  interp.eval(queryTimes.data() + 1, 3, 1, values.data());
+  EXPECT_DOUBLE_EQ(2.0, values[0]);
+  EXPECT_DOUBLE_EQ(-1.0, values[1]);
+  EXPECT_DOUBLE_EQ(-1.0, values[2]);
+}
+
+TEST(InterpolatorTest, BatchOutOfRange) {
+  vector<double> times = {0,  1,  2, 3};
+  vector<double> data = {0, 2, 1, 0};
+  Interpolator interp(data, times, linear);
+  vector<double> queryTimes = {1.0, 4.0};
+  vector<double> values(queryTimes.size());
+
+  EXPECT_THROW(interp.eval(queryTimes.data(), queryTimes.size(), 0, values.data()),
+               invalid_argument);
+  EXPECT_THROW(interp.eval(queryTimes.data(), 1, 3, values.data()),
+               invalid_argument);
+}
+
+TEST(InterpolatorTest, MoveConstruct) {
+  vector<double> times = {0,  1,  2, 3};
+  vector<double> data = {0, 2, 1, 0};
+  Interpolator interp(data, times, linear);
+  Interpolator moved(std::move(interp));
+
+  EXPECT_DOUBLE_EQ(1.5, moved.eval(1.5));
+}
+
+TEST(InterpolatorTest, ContiguousView) {
+  vector<double> times = {0,  1,  2, 3};
+  vector<double> data = {0, 2, 1, 0};
+  Interpolator interp(DataView(data), DataView(times), linear);
+
+  EXPECT_DOUBLE_EQ(1.5, interp.eval(1.5));
+
+  // Contiguous views are interpolated in place
+  data[1] = 4;
+  EXPECT_DOUBLE_EQ(2.5, interp.eval(1.5));
+}
+
+TEST(InterpolatorTest, NoTemporaryViews) {
+  // Views of temporary vectors would dangle, so they do not compile
+  EXPECT_TRUE((is_constructible<DataView, const vector<double>&>::value));
+  EXPECT_FALSE((is_constructible<DataView, vector<double>&&>::value));
+  EXPECT_FALSE((is_convertible<vector<double>&&, DataView>::value));
+}
+
+TEST(InterpolatorTest, StridedView) {
+  vector<double> data = {0, 0,
+                         1, 2,
+                         2, 1,
+                         3, 0};
+  Interpolator interp(DataView(data.data() + 1, 4, 2), DataView(data.data(), 4, 2), spline);
+
+  double tolerance = 1e-10;
+  EXPECT_NEAR(2.8 * 0.5 - 0.8 * 0.125, interp.eval(0.5), tolerance);
+  EXPECT_NEAR(3.375 - 5.4 * 2.25 + 8.2 * 1.5 - 1.8, interp.eval(1.5), tolerance);
+}
+
+TEST(InterpolatorTest, TooFewPoints) {
+  vector<double> times = {0};
+  vector<double> data = {1};
+  EXPECT_THROW(Interpolator(data, times, linear), invalid_argument);
+}
+
+TEST(InterpolatorTest, TooFewSplinePoints) {
+  vector<double> times = {0, 1};
+  vector<double> data = {1, 2};
+  EXPECT_THROW(Interpolator(data, times, spline), invalid_argument);
+}
+
+TEST(InterpolatorTest, DifferentCounts) {
+  vector<double> times = {0, 1, 2};
+  vector<double> data = {1, 2};
+  EXPECT_THROW(Interpolator(data, times, linear), invalid_argument);
+}
+
+TEST(InterpolatorTest, OutOfRange) {
+  vector<double> times = {0,  1,  2, 3};
+  vector<double> data = {0, 2, 1, 0};
+  Interpolator interp(data, times, linear);
+
+  EXPECT_THROW(interp.eval(-1.0), invalid_argument);
+  EXPECT_THROW(interp.eval(4.0), invalid_argument);
+}
+
+TEST(InterpolatorTest, BadDerivative) {
+  vector<double> times = {0,  1,  2, 3};
+  vector<double> data = {0, 2, 1, 0};
+  Interpolator interp(data, times, linear);
+
+  EXPECT_THROW(interp.eval(1.0, 3), invalid_argument);
+  EXPECT_THROW(interp.eval(1.0, -1), invalid_argument);
+}
+
+TEST(InterpolatorTest, LagrangeEvaluate) {
+  // Samples of a degree 7 polynomial at unevenly spaced times
+  vector<double> times = {0, 1, 2.5, 3, 4, 5.5, 6, 7, 8, 9.5, 10, 11};
+  vector<double> data(times.size());
+  for (size_t i = 0; i < times.size(); i++) {
+    double t = times[i] / 10;
+    data[i] = ((((((t - 2) * t + 3) * t - 1) * t + 2) * t - 3) * t + 1) * t - 5;
+  }
+  Interpolator interp(data, times, lagrange);
+
+  // The full 8 point window in the middle of the data reproduces the polynomial
+  for (double time : {4.25, 5.0, 6.5, 4.0}) {
+    double t = time / 10;
+    double expected = ((((((t - 2) * t + 3) * t - 1) * t + 2) * t - 3) * t + 1) * t - 5;
+    double expectedDeriv = (((((((7 * t - 12) * t + 15) * t - 4) * t + 6) * t - 6) * t + 1)) / 10;
+    EXPECT_NEAR(expected, interp.eval(time), 1e-12);
+    EXPECT_NEAR(expectedDeriv, interp.eval(time, 1), 1e-10);
+  }
+
+  // The window shrinks to 2 points in the first and last intervals
+  EXPECT_DOUBLE_EQ(data[0] + 0.5 * (data[1] - data[0]), interp.eval(0.5));
+  EXPECT_DOUBLE_EQ(data[10] + 0.5 * (data[11] - data[10]), interp.eval(10.5));
+  EXPECT_DOUBLE_EQ(data[11] - data[10], interp.eval(10.5, 1));
+  EXPECT_DOUBLE_EQ(0.0, interp.eval(10.5, 2));
+
+  // Every input point is reproduced
+  for (size_t i = 0; i < times.size(); i++) {
+    EXPECT_NEAR(data[i], interp.eval(times[i]), 1e-12);
+  }
+}
+
+TEST(InterpolatorTest, LagrangeBatchEvaluate) {
+  vector<double> times = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  vector<double> data = {0, 2, 1, 0, 3, 5, 4, 6, 8, 7};
+  Interpolator interp(data, times, lagrange);
+  Interpolator reference(data, times, lagrange);
+
+  vector<double> queryTimes = {0.5, 1.5, 2.5, 4.5, 4.75, 8.5, 3.25};
+  for (int d = 0; d <= 2; d++) {
+    vector<double> values(queryTimes.size());
+    interp.eval(queryTimes.data(), queryTimes.size(), d, values.data());
+    for (size_t i = 0; i < queryTimes.size(); i++) {
+      EXPECT_DOUBLE_EQ(reference.eval(queryTimes[i], d), values[i]);
+    }
+  }
+  EXPECT_THROW(interp.eval(queryTimes.data(), queryTimes.size(), 3, nullptr), invalid_argument);
+  EXPECT_THROW(interp.eval(9.5), invalid_argument);
+}
+
+TEST(InterpolatorTest, Sweep) {
+  vector<double> times = {0, 1, 2, 3, 4, 5};
+  vector<double> data = {0, 2, 1, 0, 3, 5};
+  Interpolator interp(data, times, spline);
+  Interpolator reference(data, times, spline);
+
+  vector<double> queryTimes = {0.0, 0.25, 0.25, 1.0, 3.5, 4.75, 5.0};
+  for (int d = 0; d <= 2; d++) {
+    vector<double> values(queryTimes.size());
+    interp.sweep(queryTimes.data(), queryTimes.size(), d, values.data());
+    for (size_t i = 0; i < queryTimes.size(); i++) {
+      EXPECT_DOUBLE_EQ(reference.eval(queryTimes[i], d), values[i]);
+    }
+  }
+
+  vector<double> values(queryTimes.size());
+  vector<double> unsorted = {0.5, 0.25};
+  EXPECT_THROW(interp.sweep(unsorted.data(), unsorted.size(), 0, values.data()), invalid_argument);
+  vector<double> outside = {0.5, 5.5};
+  EXPECT_THROW(interp.sweep(outside.data(), outside.size(), 0, values.data()), invalid_argument);
+}
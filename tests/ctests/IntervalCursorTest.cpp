@@ -0,0 +1,55 @@
+#include "gtest/gtest.h"
+
+#include "IntervalCursor.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+using namespace ale;
+
+TEST(IntervalCursorTest, Find) {
+  vector<double> times = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  IntervalCursor cursor;
+
+  EXPECT_EQ(0, cursor.find(times.data(), times.size(), 0.5));
+  EXPECT_EQ(7, cursor.find(times.data(), times.size(), 7.5));
+  EXPECT_EQ(7, cursor.interval());
+  EXPECT_EQ(2, cursor.find(times.data(), times.size(), 2.0));
+  EXPECT_EQ(3, cursor.find(times.data(), times.size(), 3.0));
+  EXPECT_EQ(0, cursor.find(times.data(), times.size(), 0.0));
+
+  // Times past either end clamp to the first and last intervals
+  EXPECT_EQ(8, cursor.find(times.data(), times.size(), 9.0));
+  EXPECT_EQ(8, cursor.find(times.data(), times.size(), 12.0));
+  EXPECT_EQ(0, cursor.find(times.data(), times.size(), -1.0));
+}
+
+TEST(IntervalCursorTest, MatchesBinarySearch) {
+  vector<double> times;
+  for (int i = 0; i < 100; i++) {
+    times.push_back(i * i * 0.01);
+  }
+  IntervalCursor cursor;
+  vector<double> queries = {50.0, 0.0, 98.0, 98.01, 13.3, 13.4, 0.01, 75.0, 1.0, 20.25};
+  for (double query : queries) {
+    size_t expected = upper_bound(times.begin(), times.end(), query) - times.begin() - 1;
+    expected = min(expected, times.size() - 2);
+    EXPECT_EQ(expected, cursor.find(times.data(), times.size(), query)) << query;
+  }
+}
+
+TEST(IntervalCursorTest, Advance) {
+  vector<double> times = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  IntervalCursor cursor;
+
+  EXPECT_EQ(0, cursor.advance(times.data(), times.size(), 0.0));
+  EXPECT_EQ(0, cursor.advance(times.data(), times.size(), 0.5));
+  EXPECT_EQ(1, cursor.advance(times.data(), times.size(), 1.0));
+  EXPECT_EQ(6, cursor.advance(times.data(), times.size(), 6.25));
+  EXPECT_EQ(8, cursor.advance(times.data(), times.size(), 9.0));
+
+  cursor.reset();
+  EXPECT_EQ(0, cursor.interval());
+  EXPECT_EQ(4, cursor.advance(times.data(), times.size(), 4.5));
+}
@@ -0,0 +1,372 @@
+#include "gtest/gtest.h"
+
+#include "Interpolator.h"
+#include "PiecewisePolynomial.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace ale;
+
+// Column-major samples of x = t^3 - t and y = 2t at t = -2, -1, 0, 1, 2
+static const vector<double> hermiteTimes = {-2, -1, 0, 1, 2};
+static const vector<double> hermiteValues = {-6, 0, 0, 0, 6,
+                                             -4, -2, 0, 2, 4};
+static const vector<double> hermiteDerivatives = {11, 2, -1, 2, 11,
+                                                  2, 2, 2, 2, 2};
+
+// usgscsm's lagrangeInterp from Utilities.cpp, transcribed as the reference
+// for Lagrange interpolation over a uniform grid
+static void usgscsmLagrangeInterp(const int &numTime, const double *valueArray,
+                                  const double &startTime, const double &delTime,
+                                  const double &time, const int &vectorLength,
+                                  const int &i_order, double *valueVector) {
+  // Lagrange interpolation for uniform post interval.
+  // Largest order possible is 8th. Points far away from
+  // data center are handled gracefully to avoid failure.
+
+  if (numTime < 2) {
+    throw invalid_argument("Less than 2 points for interpolation");
+  }
+
+  double fndex = (time - startTime) / delTime;
+  int index = int(fndex);
+
+  if (index < 0) {
+    index = 0;
+  }
+  if (index > numTime - 2) {
+    index = numTime - 2;
+  }
+
+  // Define order, max is 8
+
+  int order;
+  if (index >= 3 && index < numTime - 4) {
+    order = 8;
+  }
+  else if (index == 2 || index == numTime - 4) {
+    order = 6;
+  }
+  else if (index == 1 || index == numTime - 3) {
+    order = 4;
+  }
+  else {
+    order = 2;
+  }
+  if (order > i_order) {
+    order = i_order;
+  }
+
+  // Compute interpolation coefficients
+  double tp3, tp2, tp1, tm1, tm2, tm3, tm4, d[8];
+  double tau = fndex - index;
+  if (order == 2) {
+    tm1 = tau - 1;
+    d[0] = -tm1;
+    d[1] = tau;
+  }
+  else if (order == 4) {
+    tp1 = tau + 1;
+    tm1 = tau - 1;
+    tm2 = tau - 2;
+    d[0] = -tau * tm1 * tm2 / 6.0;
+    d[1] = tp1 * tm1 * tm2 / 2.0;
+    d[2] = -tp1 * tau * tm2 / 2.0;
+    d[3] = tp1 * tau * tm1 / 6.0;
+  }
+  else if (order == 6) {
+    tp2 = tau + 2;
+    tp1 = tau + 1;
+    tm1 = tau - 1;
+    tm2 = tau - 2;
+    tm3 = tau - 3;
+    d[0] = -tp1 * tau * tm1 * tm2 * tm3 / 120.0;
+    d[1] = tp2 * tau * tm1 * tm2 * tm3 / 24.0;
+    d[2] = -tp2 * tp1 * tm1 * tm2 * tm3 / 12.0;
+    d[3] = tp2 * tp1 * tau * tm2 * tm3 / 12.0;
+    d[4] = -tp2 * tp1 * tau * tm1 * tm3 / 24.0;
+    d[5] = tp2 * tp1 * tau * tm1 * tm2 / 120.0;
+  }
+  else {
+    tp3 = tau + 3;
+    tp2 = tau + 2;
+    tp1 = tau + 1;
+    tm1 = tau - 1;
+    tm2 = tau - 2;
+    tm3 = tau - 3;
+    tm4 = tau - 4;
+    d[0] = -tp2 * tp1 * tau * tm1 * tm2 * tm3 * tm4 / 5040.0;
+    d[1] = tp3 * tp1 * tau * tm1 * tm2 * tm3 * tm4 / 720.0;
+    d[2] = -tp3 * tp2 * tau * tm1 * tm2 * tm3 * tm4 / 240.0;
+    d[3] = tp3 * tp2 * tp1 * tm1 * tm2 * tm3 * tm4 / 144.0;
+    d[4] = -tp3 * tp2 * tp1 * tau * tm2 * tm3 * tm4 / 144.0;
+    d[5] = tp3 * tp2 * tp1 * tau * tm1 * tm3 * tm4 / 240.0;
+    d[6] = -tp3 * tp2 * tp1 * tau * tm1 * tm2 * tm4 / 720.0;
+    d[7] = tp3 * tp2 * tp1 * tau * tm1 * tm2 * tm3 / 5040.0;
+  }
+
+  // Compute interpolated point
+  int indx0 = index - order / 2 + 1;
+  for (int i = 0; i < vectorLength; i++) {
+    valueVector[i] = 0.0;
+  }
+
+  for (int i = 0; i < order; i++) {
+    int jndex = vectorLength * (indx0 + i);
+    for (int j = 0; j < vectorLength; j++) {
+      valueVector[j] += d[i] * valueArray[jndex + j];
+    }
+  }
+}
+
+TEST(PiecewisePolynomialTest, HermiteEvaluate) {
+  PiecewisePolynomial poly = PiecewisePolynomial::hermite(
+        hermiteTimes,
+        MatrixView(hermiteValues.data(), 2, 5, 5, 1),
+        MatrixView(hermiteDerivatives.data(), 2, 5, 5, 1));
+  ASSERT_EQ(poly.size(), 5);
+  ASSERT_EQ(poly.numChannels(), 2);
+
+  // A cubic is reproduced exactly from its values and derivatives
+  double values[2];
+  double derivatives[2];
+  for (double t : {-2.0, -1.25, -0.5, 0.0, 0.75, 1.5, 2.0}) {
+    poly.evaluate(t, values, derivatives);
+    EXPECT_NEAR(t * t * t - t, values[0], 1e-12);
+    EXPECT_NEAR(2 * t, values[1], 1e-12);
+    EXPECT_NEAR(3 * t * t - 1, derivatives[0], 1e-12);
+    EXPECT_NEAR(2.0, derivatives[1], 1e-12);
+  }
+
+  poly.evaluate(0.5, values);
+  EXPECT_NEAR(-0.375, values[0], 1e-12);
+}
+
+TEST(PiecewisePolynomialTest, BatchEvaluate) {
+  PiecewisePolynomial poly = PiecewisePolynomial::hermite(
+        hermiteTimes,
+        MatrixView(hermiteValues.data(), 2, 5, 5, 1),
+        MatrixView(hermiteDerivatives.data(), 2, 5, 5, 1));
+
+  vector<double> times = {1.5, -1.5, 0.25, 2.0};
+  vector<double> values(2 * times.size());
+  vector<double> derivatives(2 * times.size());
+  poly.evaluate(times.data(), times.size(), values.data(), derivatives.data());
+  for (size_t i = 0; i < times.size(); i++) {
+    double expected[2];
+    double expectedDerivatives[2];
+    poly.evaluate(times[i], expected, expectedDerivatives);
+    EXPECT_DOUBLE_EQ(expected[0], values[2 * i]);
+    EXPECT_DOUBLE_EQ(expected[1], values[2 * i + 1]);
+    EXPECT_DOUBLE_EQ(expectedDerivatives[0], derivatives[2 * i]);
+    EXPECT_DOUBLE_EQ(expectedDerivatives[1], derivatives[2 * i + 1]);
+  }
+
+  // Only the derivatives
+  vector<double> onlyDerivatives(2 * times.size());
+  poly.evaluate(times.data(), times.size(), nullptr, onlyDerivatives.data());
+  EXPECT_EQ(derivatives, onlyDerivatives);
+}
+
+TEST(PiecewisePolynomialTest, RowMajorView) {
+  vector<double> values = {0, 0, 1, 1};
+  vector<double> derivatives = {1, 0, 1, 0};
+  vector<double> times = {0, 1};
+  PiecewisePolynomial poly = PiecewisePolynomial::hermite(
+        times,
+        MatrixView(values.data(), 2, 2, 1, 2),
+        MatrixView(derivatives.data(), 2, 2, 1, 2));
+
+  double result[2];
+  poly.evaluate(0.5, result);
+  EXPECT_DOUBLE_EQ(0.5, result[0]);
+  EXPECT_DOUBLE_EQ(0.5, result[1]);
+}
+
+TEST(PiecewisePolynomialTest, BadInput) {
+  vector<double> values = {0, 1, 2};
+  vector<double> derivatives = {1, 1, 1};
+  MatrixView valueView(values.data(), 1, 3, 3, 1);
+  MatrixView derivativeView(derivatives.data(), 1, 3, 3, 1);
+
+  vector<double> unsorted = {0, 2, 1};
+  EXPECT_THROW(PiecewisePolynomial::hermite(unsorted, valueView, derivativeView),
+               invalid_argument);
+  vector<double> tooFew = {0, 1};
+  EXPECT_THROW(PiecewisePolynomial::hermite(tooFew, valueView, derivativeView),
+               invalid_argument);
+  vector<double> times = {0, 1, 2};
+  EXPECT_THROW(PiecewisePolynomial::hermite(times, valueView,
+                                            MatrixView(derivatives.data(), 1, 2, 2, 1)),
+               invalid_argument);
+
+  PiecewisePolynomial poly = PiecewisePolynomial::hermite(times, valueView, derivativeView);
+  double result;
+  EXPECT_THROW(poly.evaluate(-0.5, &result), invalid_argument);
+  EXPECT_THROW(poly.evaluate(2.5, &result), invalid_argument);
+}
+
+TEST(PiecewisePolynomialTest, Sweep) {
+  PiecewisePolynomial poly = PiecewisePolynomial::hermite(
+        hermiteTimes,
+        MatrixView(hermiteValues.data(), 2, 5, 5, 1),
+        MatrixView(hermiteDerivatives.data(), 2, 5, 5, 1));
+
+  vector<double> times = {-2.0, -0.5, 0.0, 0.25, 1.75, 2.0};
+  vector<double> values(2 * times.size());
+  vector<double> derivatives(2 * times.size());
+  poly.sweep(times.data(), times.size(), values.data(), derivatives.data());
+  for (size_t i = 0; i < times.size(); i++) {
+    double t = times[i];
+    EXPECT_NEAR(t * t * t - t, values[2 * i], 1e-12);
+    EXPECT_NEAR(2 * t, values[2 * i + 1], 1e-12);
+    EXPECT_NEAR(3 * t * t - 1, derivatives[2 * i], 1e-12);
+  }
+
+  vector<double> unsorted = {0.5, 0.25};
+  EXPECT_THROW(poly.sweep(unsorted.data(), unsorted.size(), values.data()), invalid_argument);
+}
+
+TEST(PiecewisePolynomialTest, UniformTimeGrid) {
+  vector<double> times = {0, 0.5, 1, 1.5, 2, 2.5, 3, 3.5, 4, 4.5};
+  vector<double> values(2 * times.size());
+  for (size_t i = 0; i < times.size(); i++) {
+    values[i] = sin(times[i]);
+    values[times.size() + i] = times[i] * times[i];
+  }
+  MatrixView valueView(values.data(), 2, times.size(), times.size(), 1);
+  UniformTimeGrid grid(0, 0.5, times.size());
+
+  vector<PiecewisePolynomial> explicitTimes = {
+    PiecewisePolynomial::linear(times, valueView),
+    PiecewisePolynomial::spline(times, valueView),
+    PiecewisePolynomial::lagrange(times, valueView)};
+  vector<PiecewisePolynomial> uniformTimes = {
+    PiecewisePolynomial::linear(grid, valueView),
+    PiecewisePolynomial::spline(grid, valueView),
+    PiecewisePolynomial::lagrange(grid, valueView)};
+  for (size_t i = 0; i < explicitTimes.size(); i++) {
+    EXPECT_FALSE(explicitTimes[i].isUniform());
+    EXPECT_TRUE(uniformTimes[i].isUniform());
+    for (double t : {0.0, 0.3, 1.0, 2.2, 4.1, 4.5}) {
+      double expected[2];
+      double expectedDerivatives[2];
+      double result[2];
+      double derivatives[2];
+      explicitTimes[i].evaluate(t, expected, expectedDerivatives);
+      uniformTimes[i].evaluate(t, result, derivatives);
+      for (size_t c = 0; c < 2; c++) {
+        EXPECT_NEAR(expected[c], result[c], 1e-12);
+        EXPECT_NEAR(expectedDerivatives[c], derivatives[c], 1e-12);
+      }
+    }
+  }
+
+  // Lagrange and linear interpolation reproduce the samples
+  double result[2];
+  uniformTimes[2].evaluate(2.5, result);
+  EXPECT_NEAR(sin(2.5), result[0], 1e-12);
+  uniformTimes[0].evaluate(1.25, result);
+  EXPECT_NEAR(1.625, result[1], 1e-12);
+
+  EXPECT_THROW(uniformTimes[0].evaluate(4.6, result), invalid_argument);
+  EXPECT_THROW(PiecewisePolynomial::linear(UniformTimeGrid(0, 1, 3), valueView), invalid_argument);
+}
+
+TEST(PiecewisePolynomialTest, LagrangeMatchesUsgscsm) {
+  // Row-major positions, like the arrays usgscsm interpolates over
+  size_t numTimes = 12;
+  double startTime = 100.25;
+  double step = 0.3;
+  vector<double> positions(3 * numTimes);
+  for (size_t i = 0; i < numTimes; i++) {
+    double t = startTime + i * step;
+    positions[3 * i] = 1737400 * cos(t / 7);
+    positions[3 * i + 1] = 1737400 * sin(t / 7);
+    positions[3 * i + 2] = 1000 * t * t - 3 * t;
+  }
+  PiecewisePolynomial poly = PiecewisePolynomial::lagrange(
+        UniformTimeGrid(startTime, step, numTimes),
+        MatrixView(positions.data(), 3, numTimes, 1, 3));
+
+  // Every window size from both ends, on and between the samples
+  for (size_t i = 0; i <= 4 * (numTimes - 1); i++) {
+    double time = startTime + i * step / 4 + 0.01 * (i % 3);
+    if (time > startTime + (numTimes - 1) * step) {
+      time = startTime + (numTimes - 1) * step;
+    }
+    double expected[3];
+    double result[3];
+    usgscsmLagrangeInterp(numTimes, positions.data(), startTime, step, time, 3, 8, expected);
+    poly.evaluate(time, result);
+    for (size_t c = 0; c < 3; c++) {
+      EXPECT_EQ(expected[c], result[c]) << "at time " << time;
+    }
+  }
+}
+
+TEST(PiecewisePolynomialTest, LagrangeMatchesInterpolator) {
+  vector<double> times = {0, 1, 2.5, 3, 4, 5.5, 6, 7, 8, 9.5, 10, 11};
+  vector<double> values(times.size());
+  for (size_t i = 0; i < times.size(); i++) {
+    values[i] = sin(times[i] / 3) * 1000;
+  }
+  PiecewisePolynomial poly = PiecewisePolynomial::lagrange(
+        times, MatrixView(values.data(), 1, times.size(), times.size(), 1));
+  Interpolator interp(values, times, lagrange);
+
+  // Both are evaluated with the same weights, so they agree exactly
+  for (double time = 0; time <= 11; time += 0.125) {
+    double value;
+    double derivative;
+    poly.evaluate(time, &value, &derivative);
+    EXPECT_EQ(interp.eval(time), value);
+    EXPECT_EQ(interp.eval(time, 1), derivative);
+  }
+}
+
+TEST(PiecewisePolynomialTest, TryEvaluate) {
+  vector<double> times = {0, 1, 2};
+  vector<double> values = {0, 1, 4};
+  PiecewisePolynomial poly = PiecewisePolynomial::linear(times, MatrixView(values.data(), 1, 3, 3, 1));
+  ASSERT_EQ(poly.extrapolationMode(), noExtrapolation);
+
+  double value = -1;
+  double derivative = -1;
+  EXPECT_EQ(evaluated, poly.tryEvaluate(1.5, &value, &derivative));
+  EXPECT_DOUBLE_EQ(2.5, value);
+  EXPECT_DOUBLE_EQ(3.0, derivative);
+
+  value = -1;
+  EXPECT_EQ(outOfRange, poly.tryEvaluate(2.5, &value));
+  EXPECT_EQ(outOfRange, poly.tryEvaluate(nan(""), &value));
+  EXPECT_DOUBLE_EQ(-1, value);
+
+  poly.setExtrapolation(clampToEnds);
+  EXPECT_EQ(clamped, poly.tryEvaluate(2.5, &value, &derivative));
+  EXPECT_DOUBLE_EQ(4.0, value);
+  EXPECT_DOUBLE_EQ(0.0, derivative);
+  EXPECT_EQ(clamped, poly.tryEvaluate(-1, &value));
+  EXPECT_DOUBLE_EQ(0.0, value);
+
+  poly.setExtrapolation(extrapolateEnds);
+  EXPECT_EQ(extrapolated, poly.tryEvaluate(2.5, &value, &derivative));
+  EXPECT_DOUBLE_EQ(5.5, value);
+  EXPECT_DOUBLE_EQ(3.0, derivative);
+  EXPECT_EQ(extrapolated, poly.tryEvaluate(-0.5, &value));
+  EXPECT_DOUBLE_EQ(-0.5, value);
+  EXPECT_EQ(outOfRange, poly.tryEvaluate(nan(""), &value));
+
+  // The batch status is the worst of the times
+  vector<double> queryTimes = {0.5, 3.0, 1.0};
+  vector<double> results(3);
+  EXPECT_EQ(extrapolated, poly.tryEvaluate(queryTimes.data(), queryTimes.size(), results.data()));
+  EXPECT_DOUBLE_EQ(0.5, results[0]);
+  EXPECT_DOUBLE_EQ(7.0, results[1]);
+  EXPECT_DOUBLE_EQ(1.0, results[2]);
+  poly.setExtrapolation(noExtrapolation);
+  EXPECT_EQ(outOfRange, poly.tryEvaluate(queryTimes.data(), queryTimes.size(), results.data()));
+}
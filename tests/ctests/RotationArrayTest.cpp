@@ -0,0 +1,173 @@
+#include "gtest/gtest.h"
+
+#include "RotationArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace ale;
+
+// Rotations stored w, w, w, x, x, x, ...
+static const vector<double> quaternions = {0.5, 1.0, 0.2,
+                                           0.5, 0.0, -0.4,
+                                           0.5, 0.0, 0.7,
+                                           0.5, 0.0, 0.1};
+
+static RotationArray testRotations() {
+  return RotationArray(MatrixView(quaternions.data(), 4, 3, 3, 1));
+}
+
+static void expectSameRotation(const Rotation &expected, const Rotation &actual) {
+  vector<double> expectedQuat = expected.toQuaternion();
+  vector<double> actualQuat = actual.toQuaternion();
+  double sign = expectedQuat[0] * actualQuat[0] + expectedQuat[1] * actualQuat[1] +
+                expectedQuat[2] * actualQuat[2] + expectedQuat[3] * actualQuat[3] < 0 ? -1 : 1;
+  for (int i = 0; i < 4; i++) {
+    EXPECT_NEAR(expectedQuat[i], sign * actualQuat[i], 1e-12);
+  }
+}
+
+TEST(RotationArrayTest, Identity) {
+  RotationArray rotations(2);
+  ASSERT_EQ(rotations.size(), 2);
+  vector<double> quats(8);
+  rotations.toQuaternions(quats.data());
+  EXPECT_EQ(quats, vector<double>({1, 0, 0, 0, 1, 0, 0, 0}));
+}
+
+TEST(RotationArrayTest, Quaternions) {
+  RotationArray rotations = testRotations();
+  ASSERT_EQ(rotations.size(), 3);
+  for (size_t i = 0; i < 3; i++) {
+    Rotation expected(quaternions[i], quaternions[3 + i], quaternions[6 + i], quaternions[9 + i]);
+    expectSameRotation(expected, rotations[i]);
+  }
+
+  // The quaternions are normalized
+  MatrixView view = rotations.quaternions();
+  double norm = view(0, 2) * view(0, 2) + view(1, 2) * view(1, 2) +
+                view(2, 2) * view(2, 2) + view(3, 2) * view(3, 2);
+  EXPECT_NEAR(1.0, norm, 1e-12);
+
+  EXPECT_THROW(RotationArray(MatrixView(quaternions.data(), 3, 3, 3, 1)), invalid_argument);
+}
+
+TEST(RotationArrayTest, MultiplyAndInverse) {
+  RotationArray rotations = testRotations();
+  RotationArray inverse = rotations.inverse();
+  RotationArray product = inverse * rotations;
+  RotationArray chained = rotations * rotations;
+  for (size_t i = 0; i < 3; i++) {
+    expectSameRotation(Rotation(), product[i]);
+    expectSameRotation(rotations[i].inverse(), inverse[i]);
+    expectSameRotation(rotations[i] * rotations[i], chained[i]);
+  }
+
+  EXPECT_THROW(rotations * RotationArray(2), invalid_argument);
+}
+
+TEST(RotationArrayTest, Matrices) {
+  RotationArray rotations = testRotations();
+  vector<double> matrices(27);
+  rotations.toMatrices(matrices.data());
+  for (size_t i = 0; i < 3; i++) {
+    vector<double> expected = rotations[i].toRotationMatrix();
+    for (size_t j = 0; j < 9; j++) {
+      EXPECT_NEAR(expected[j], matrices[9 * i + j], 1e-12);
+    }
+  }
+
+  RotationArray fromMatrices = RotationArray::fromMatrices(matrices.data(), 3);
+  for (size_t i = 0; i < 3; i++) {
+    expectSameRotation(rotations[i], fromMatrices[i]);
+  }
+}
+
+TEST(RotationArrayTest, Euler) {
+  // Two sets of ZXZ angles
+  vector<double> angles = {0.3, -1.2,
+                           1.1, 0.4,
+                           -2.0, 2.5};
+  vector<int> axes = {2, 0, 2};
+  RotationArray rotations = RotationArray::fromEuler(MatrixView(angles.data(), 3, 2, 2, 1), axes);
+  for (size_t i = 0; i < 2; i++) {
+    expectSameRotation(Rotation({angles[i], angles[2 + i], angles[4 + i]}, axes), rotations[i]);
+  }
+
+  vector<double> euler(6);
+  rotations.toEuler({0, 1, 2}, euler.data());
+  for (size_t i = 0; i < 2; i++) {
+    vector<double> expected = rotations[i].toEuler({0, 1, 2});
+    for (size_t j = 0; j < 3; j++) {
+      EXPECT_NEAR(expected[j], euler[3 * i + j], 1e-12);
+    }
+  }
+
+  EXPECT_THROW(RotationArray::fromEuler(MatrixView(angles.data(), 3, 2, 2, 1), {0, 1}),
+               invalid_argument);
+  EXPECT_THROW(RotationArray::fromEuler(MatrixView(angles.data(), 3, 2, 2, 1), {0, 1, 3}),
+               invalid_argument);
+  EXPECT_THROW(rotations.toEuler({0, 1}, euler.data()), invalid_argument);
+}
+
+TEST(RotationArrayTest, VectorBlocks) {
+  // Enough rotations for two blocks of four and a remainder. The half turns
+  // and near half turns have a negative trace, so fromMatrices has to take
+  // each of the x, y, and z diagonal branches as well as the trace branch.
+  vector<Rotation> expected = {
+    Rotation({1, 0, 0}, M_PI),
+    Rotation({0, 1, 0}, M_PI),
+    Rotation({0, 0, 1}, M_PI),
+    Rotation({1, 0.1, -0.2}, 3.0),
+    Rotation({0.1, 1, 0.3}, 3.1),
+    Rotation({-0.2, 0.1, 1}, 2.9),
+    Rotation({1, 2, 3}, 0.4),
+    Rotation({-1, 0.5, 0.2}, 1.3),
+    Rotation({0.3, -0.7, 0.1}, 2.2),
+    Rotation({0, 0, 1}, 0.0),
+    Rotation({2, -1, 1}, -0.8)};
+  const size_t size = expected.size();
+
+  vector<double> matrices(9 * size);
+  for (size_t i = 0; i < size; i++) {
+    vector<double> matrix = expected[i].toRotationMatrix();
+    copy(matrix.begin(), matrix.end(), matrices.begin() + 9 * i);
+  }
+  RotationArray rotations = RotationArray::fromMatrices(matrices.data(), size);
+  ASSERT_EQ(rotations.size(), size);
+  for (size_t i = 0; i < size; i++) {
+    expectSameRotation(expected[i], rotations[i]);
+  }
+
+  vector<double> roundTrip(9 * size);
+  rotations.toMatrices(roundTrip.data());
+  for (size_t i = 0; i < 9 * size; i++) {
+    EXPECT_NEAR(matrices[i], roundTrip[i], 1e-12);
+  }
+
+  RotationArray inverse = rotations.inverse();
+  RotationArray product = rotations * inverse.inverse();
+  for (size_t i = 0; i < size; i++) {
+    expectSameRotation(expected[i].inverse(), inverse[i]);
+    expectSameRotation(expected[i] * expected[i], product[i]);
+  }
+
+  vector<double> euler(3 * size);
+  rotations.toEuler({2, 0, 2}, euler.data());
+  vector<double> angles(3 * size);
+  for (size_t i = 0; i < size; i++) {
+    vector<double> expectedEuler = expected[i].toEuler({2, 0, 2});
+    for (size_t j = 0; j < 3; j++) {
+      EXPECT_NEAR(expectedEuler[j], euler[3 * i + j], 1e-12);
+      angles[j * size + i] = euler[3 * i + j];
+    }
+  }
+  RotationArray fromEuler = RotationArray::fromEuler(MatrixView(angles.data(), 3, size, size, 1),
+                                                     {2, 0, 2});
+  for (size_t i = 0; i < size; i++) {
+    expectSameRotation(expected[i], fromEuler[i]);
+  }
+}
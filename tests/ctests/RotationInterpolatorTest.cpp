@@ -0,0 +1,200 @@
+#include "gtest/gtest.h"
+
+#include "RotationInterpolator.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace ale;
+
+// Build w, x, y, z components of rotations about an axis
+static vector<double> axisRotations(const vector<double> &angles, double x, double y, double z) {
+  size_t n = angles.size();
+  vector<double> quats(4 * n);
+  for (size_t i = 0; i < n; i++) {
+    quats[i] = cos(angles[i] / 2);
+    quats[n + i] = x * sin(angles[i] / 2);
+    quats[2 * n + i] = y * sin(angles[i] / 2);
+    quats[3 * n + i] = z * sin(angles[i] / 2);
+  }
+  return quats;
+}
+
+TEST(RotationInterpolatorTest, Slerp) {
+  // Turning about Z at 0.5 then 1 radian per second
+  vector<double> times = {0, 1, 2};
+  vector<double> quats = axisRotations({0, 0.5, 1.5}, 0, 0, 1);
+  RotationInterpolator interpolator(MatrixView(quats.data(), 4, 3, 3, 1), times, slerp);
+  ASSERT_EQ(interpolator.size(), 3);
+
+  double quat[4];
+  double av[3];
+  ASSERT_EQ(evaluated, interpolator.state(0.5, quat, av));
+  EXPECT_NEAR(cos(0.125), quat[0], 1e-12);
+  EXPECT_NEAR(sin(0.125), quat[3], 1e-12);
+  EXPECT_NEAR(0, av[0], 1e-12);
+  EXPECT_NEAR(0.5, av[2], 1e-12);
+
+  // A time on a rotation uses the interval that ends there
+  ASSERT_EQ(evaluated, interpolator.state(1, quat, av));
+  EXPECT_NEAR(cos(0.25), quat[0], 1e-12);
+  EXPECT_NEAR(0.5, av[2], 1e-12);
+  ASSERT_EQ(evaluated, interpolator.state(1.5, quat, av));
+  EXPECT_NEAR(cos(0.5), quat[0], 1e-12);
+  EXPECT_NEAR(1.0, av[2], 1e-12);
+}
+
+TEST(RotationInterpolatorTest, MatchesRotationInterpolate) {
+  vector<double> times = {0, 2};
+  double startNorm = sqrt(0.9 * 0.9 + 0.1 * 0.1 + 0.3 * 0.3 + 0.2 * 0.2);
+  double endNorm = sqrt(0.1 * 0.1 + 0.4 * 0.4 + 0.5 * 0.5 + 0.6 * 0.6);
+  vector<double> quats = {0.9 / startNorm, 0.1 / endNorm,
+                          0.1 / startNorm, -0.4 / endNorm,
+                          0.3 / startNorm, 0.5 / endNorm,
+                          -0.2 / startNorm, 0.6 / endNorm};
+  RotationInterpolator interpolator(MatrixView(quats.data(), 4, 2, 2, 1), times, slerp);
+  Rotation start(quats[0], quats[2], quats[4], quats[6]);
+  Rotation end(quats[1], quats[3], quats[5], quats[7]);
+
+  vector<double> queryTimes = {0.0, 0.3, 1.0, 1.7, 2.0};
+  vector<double> results(4 * queryTimes.size());
+  ASSERT_EQ(evaluated, interpolator.states(queryTimes.data(), queryTimes.size(),
+                                           results.data(), nullptr));
+  for (size_t i = 0; i < queryTimes.size(); i++) {
+    vector<double> expected = start.interpolate(end, queryTimes[i] / 2, slerp).toQuaternion();
+    double sign = expected[0] * results[4 * i] < 0 ? -1 : 1;
+    for (size_t j = 0; j < 4; j++) {
+      EXPECT_NEAR(expected[j], sign * results[4 * i + j], 1e-12);
+    }
+  }
+}
+
+TEST(RotationInterpolatorTest, Nlerp) {
+  vector<double> times = {0, 1};
+  vector<double> quats = axisRotations({0, 1}, 1, 0, 0);
+  RotationInterpolator interpolator(MatrixView(quats.data(), 4, 2, 2, 1), times, nlerp);
+
+  double quat[4];
+  double av[3];
+  ASSERT_EQ(evaluated, interpolator.state(0.5, quat, av));
+  // Halfway is the same for nlerp and slerp, but nlerp turns fastest there
+  EXPECT_NEAR(cos(0.25), quat[0], 1e-12);
+  EXPECT_NEAR(sin(0.25), quat[1], 1e-12);
+  EXPECT_GT(av[0], 1.0);
+  EXPECT_NEAR(0, av[1], 1e-12);
+}
+
+TEST(RotationInterpolatorTest, FastSlerp) {
+  vector<double> times = {0, 1, 2};
+  vector<double> quats = axisRotations({0, 0.5, 1.5}, 0, 0, 1);
+  RotationInterpolator fast(MatrixView(quats.data(), 4, 3, 3, 1), times, fastSlerp, extrapolateEnds);
+  RotationInterpolator exact(MatrixView(quats.data(), 4, 3, 3, 1), times, slerp, extrapolateEnds);
+  ASSERT_EQ(fastSlerp, fast.interpolationType());
+
+  vector<double> queryTimes = {-0.5, 0.0, 0.3, 1.0, 1.6, 2.0, 2.5};
+  vector<double> fastQuats(4 * queryTimes.size());
+  vector<double> fastAvs(3 * queryTimes.size());
+  vector<double> exactQuats(4 * queryTimes.size());
+  vector<double> exactAvs(3 * queryTimes.size());
+  ASSERT_EQ(extrapolated, fast.states(queryTimes.data(), queryTimes.size(),
+                                      fastQuats.data(), fastAvs.data()));
+  exact.states(queryTimes.data(), queryTimes.size(), exactQuats.data(), exactAvs.data());
+  // The second interval turns 1 radian
+  for (size_t i = 0; i < fastQuats.size(); i++) {
+    EXPECT_NEAR(exactQuats[i], fastQuats[i], 1e-8);
+  }
+  for (size_t i = 0; i < fastAvs.size(); i++) {
+    EXPECT_EQ(exactAvs[i], fastAvs[i]);
+  }
+}
+
+TEST(RotationInterpolatorTest, Squad) {
+  // A constant rate about a fixed axis is reproduced exactly
+  vector<double> angles = {0, 0.2, 0.4, 0.6, 0.8};
+  vector<double> quats = axisRotations(angles, 0, 0.6, 0.8);
+  RotationInterpolator interpolator(MatrixView(quats.data(), 4, 5, 5, 1),
+                                    UniformTimeGrid(0, 1, 5), squad);
+  double quat[4];
+  double av[3];
+  ASSERT_EQ(evaluated, interpolator.state(2.3, quat, av));
+  EXPECT_NEAR(cos(0.23), quat[0], 1e-12);
+  EXPECT_NEAR(0.8 * sin(0.23), quat[3], 1e-12);
+  EXPECT_NEAR(0.12, av[1], 1e-12);
+  EXPECT_NEAR(0.16, av[2], 1e-12);
+}
+
+TEST(RotationInterpolatorTest, SquadAngularVelocity) {
+  vector<double> times = {0, 1, 2, 3};
+  vector<double> quats = {1.0, 0.9, 0.7, 0.4,
+                          0.0, 0.3, 0.1, -0.3,
+                          0.0, 0.2, 0.6, 0.5,
+                          0.0, -0.1, 0.2, 0.7};
+  RotationInterpolator interpolator(MatrixView(quats.data(), 4, 4, 4, 1), times, squad);
+
+  // The rotations are interpolated exactly
+  double quat[4];
+  ASSERT_EQ(evaluated, interpolator.rotation(2, quat));
+  double norm = sqrt(0.7 * 0.7 + 0.1 * 0.1 + 0.6 * 0.6 + 0.2 * 0.2);
+  EXPECT_NEAR(0.7 / norm, quat[0], 1e-12);
+  EXPECT_NEAR(0.6 / norm, quat[2], 1e-12);
+
+  // The angular velocity matches a finite difference of the rotations
+  for (double t : {0.1, 0.5, 1.2, 1.9, 2.5}) {
+    double before[4], after[4], av[3];
+    double step = 1e-6;
+    interpolator.state(t, nullptr, av);
+    interpolator.rotation(t - step, before);
+    interpolator.rotation(t + step, after);
+    Rotation change = Rotation(after[0], after[1], after[2], after[3]) *
+                      Rotation(before[0], before[1], before[2], before[3]).inverse();
+    pair<vector<double>, double> axisAngle = change.toAxisAngle();
+    for (int i = 0; i < 3; i++) {
+      EXPECT_NEAR(axisAngle.first[i] * axisAngle.second / (2 * step), av[i], 1e-6);
+    }
+  }
+
+  // And it is continuous across the rotations
+  double left[3], right[3];
+  interpolator.state(1 - 1e-9, nullptr, left);
+  interpolator.state(1 + 1e-9, nullptr, right);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(left[i], right[i], 1e-6);
+  }
+}
+
+TEST(RotationInterpolatorTest, Extrapolation) {
+  vector<double> times = {0, 1};
+  vector<double> quats = axisRotations({0, 0.5}, 0, 0, 1);
+  MatrixView quatView(quats.data(), 4, 2, 2, 1);
+
+  double quat[4] = {-1, -1, -1, -1};
+  double av[3];
+  EXPECT_EQ(outOfRange, RotationInterpolator(quatView, times, slerp).rotation(2, quat));
+  EXPECT_EQ(-1, quat[0]);
+
+  RotationInterpolator extrapolator(quatView, times, squad, extrapolateEnds);
+  ASSERT_EQ(extrapolated, extrapolator.state(3, quat, av));
+  EXPECT_NEAR(cos(0.75), quat[0], 1e-12);
+  EXPECT_NEAR(sin(0.75), quat[3], 1e-12);
+  EXPECT_NEAR(0.5, av[2], 1e-12);
+
+  RotationInterpolator clamper(quatView, times, slerp, clampToEnds);
+  ASSERT_EQ(clamped, clamper.state(-1, quat, av));
+  EXPECT_NEAR(1, quat[0], 1e-12);
+  EXPECT_NEAR(0, av[2], 1e-12);
+}
+
+TEST(RotationInterpolatorTest, BadInput) {
+  vector<double> quats = axisRotations({0, 0.5}, 0, 0, 1);
+  vector<double> times = {0, 1};
+  vector<double> decreasingTimes = {1, 0};
+  vector<double> singleTime = {0};
+  EXPECT_THROW(RotationInterpolator(MatrixView(quats.data(), 3, 2, 2, 1), times, slerp),
+               invalid_argument);
+  EXPECT_THROW(RotationInterpolator(MatrixView(quats.data(), 4, 2, 2, 1), decreasingTimes, slerp),
+               invalid_argument);
+  EXPECT_THROW(RotationInterpolator(MatrixView(quats.data(), 4, 1, 2, 1), singleTime, slerp),
+               invalid_argument);
+}
@@ -0,0 +1,219 @@
+#include "gtest/gtest.h"
+
+#include "Rotation.h"
+#include "RotationTable.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace ale;
+
+// Rotations about Z by 0, 90, and 180 degrees
+static const double halfRoot2 = sqrt(0.5);
+static const vector<double> rotationTimes = {0, 1, 2};
+static const vector<double> zRotations = {1, halfRoot2, 0,
+                                          0, 0, 0,
+                                          0, 0, 0,
+                                          0, halfRoot2, 1};
+
+TEST(RotationTableTest, Rotation) {
+  RotationTable table(MatrixView(zRotations.data(), 4, 3, 3, 1), rotationTimes, linear);
+  ASSERT_EQ(table.size(), 3);
+
+  double quat[4];
+  ASSERT_EQ(evaluated, table.rotation(1, quat));
+  EXPECT_NEAR(halfRoot2, quat[0], 1e-12);
+  EXPECT_NEAR(0, quat[1], 1e-12);
+  EXPECT_NEAR(0, quat[2], 1e-12);
+  EXPECT_NEAR(halfRoot2, quat[3], 1e-12);
+
+  // The interpolated quaternion is normalized
+  ASSERT_EQ(evaluated, table.rotation(0.5, quat));
+  EXPECT_NEAR(1.0, quat[0] * quat[0] + quat[3] * quat[3], 1e-12);
+  EXPECT_NEAR(halfRoot2 / (1 + halfRoot2), quat[3] / quat[0], 1e-12);
+
+  double av[3];
+  ASSERT_EQ(evaluated, table.angularVelocity(1.5, av));
+  EXPECT_NEAR(0, av[0], 1e-12);
+  EXPECT_NEAR(0, av[1], 1e-12);
+  EXPECT_LT(av[2], 0);
+}
+
+TEST(RotationTableTest, SignAlignment) {
+  // The same rotations with the middle quaternion negated and unnormalized
+  vector<double> flipped = zRotations;
+  flipped[1] = -2 * halfRoot2;
+  flipped[10] = -2 * halfRoot2;
+  RotationTable table(MatrixView(zRotations.data(), 4, 3, 3, 1), rotationTimes, spline);
+  RotationTable flippedTable(MatrixView(flipped.data(), 4, 3, 3, 1), rotationTimes, spline);
+
+  vector<double> times = {0.25, 0.5, 1.0, 1.75};
+  vector<double> quats(4 * times.size());
+  vector<double> flippedQuats(4 * times.size());
+  vector<double> avs(3 * times.size());
+  vector<double> flippedAvs(3 * times.size());
+  ASSERT_EQ(evaluated, table.states(times.data(), times.size(), quats.data(), avs.data()));
+  ASSERT_EQ(evaluated, flippedTable.states(times.data(), times.size(),
+                                           flippedQuats.data(), flippedAvs.data()));
+  for (size_t i = 0; i < quats.size(); i++) {
+    EXPECT_NEAR(quats[i], flippedQuats[i], 1e-12);
+  }
+  for (size_t i = 0; i < avs.size(); i++) {
+    EXPECT_NEAR(avs[i], flippedAvs[i], 1e-12);
+  }
+}
+
+TEST(RotationTableTest, Extrapolation) {
+  RotationTable table(MatrixView(zRotations.data(), 4, 3, 3, 1), UniformTimeGrid(0, 1, 3),
+                      linear, clampToEnds);
+
+  double quat[4] = {-1, -1, -1, -1};
+  double av[3] = {-1, -1, -1};
+  ASSERT_EQ(clamped, table.state(2.5, quat, av));
+  EXPECT_NEAR(0, quat[0], 1e-12);
+  EXPECT_NEAR(1, quat[3], 1e-12);
+  EXPECT_NEAR(0, av[2], 1e-12);
+
+  RotationTable strictTable(MatrixView(zRotations.data(), 4, 3, 3, 1), rotationTimes, linear);
+  quat[0] = -1;
+  EXPECT_EQ(outOfRange, strictTable.rotation(-0.5, quat));
+  EXPECT_EQ(-1, quat[0]);
+}
+
+TEST(RotationTableTest, QuaternionTable) {
+  QuaternionTable rotations(rotationTimes, {{1, halfRoot2, 0}, {0, 0, 0}, {0, 0, 0}, {0, halfRoot2, 1}});
+  RotationTable table(rotations, linear);
+  RotationTable expected(MatrixView(zRotations.data(), 4, 3, 3, 1), rotationTimes, linear);
+
+  double quat[4];
+  double expectedQuat[4];
+  ASSERT_EQ(evaluated, table.rotation(1.25, quat));
+  ASSERT_EQ(evaluated, expected.rotation(1.25, expectedQuat));
+  for (int i = 0; i < 4; i++) {
+    EXPECT_DOUBLE_EQ(expectedQuat[i], quat[i]);
+  }
+}
+
+TEST(RotationTableTest, BadInput) {
+  EXPECT_THROW(RotationTable(MatrixView(zRotations.data(), 3, 3, 3, 1), rotationTimes, linear),
+               invalid_argument);
+  EXPECT_THROW(RotationTable(MatrixView(zRotations.data(), 4, 3, 3, 1), rotationTimes, hermite),
+               invalid_argument);
+}
+
+TEST(RotationTableTest, Hermite) {
+  // A constant rate rotation about Z, sampled every 90 degrees
+  const double rate = M_PI / 2;
+  vector<double> avs = {0, 0, 0,
+                        0, 0, 0,
+                        rate, rate, rate};
+  vector<double> negatedAvs = {0, 0, 0,
+                               0, 0, 0,
+                               -rate, -rate, -rate};
+  RotationTable table(MatrixView(zRotations.data(), 4, 3, 3, 1),
+                      MatrixView(avs.data(), 3, 3, 3, 1), rotationTimes);
+  RotationTable negatedTable(MatrixView(zRotations.data(), 4, 3, 3, 1),
+                             MatrixView(negatedAvs.data(), 3, 3, 3, 1), rotationTimes,
+                             noExtrapolation, negatedSourceFrame);
+  RotationTable linearTable(MatrixView(zRotations.data(), 4, 3, 3, 1), rotationTimes, linear);
+
+  // The angular velocities are reproduced at each time, in the convention
+  // angularVelocity returns
+  double quat[4];
+  double av[3];
+  for (double time : rotationTimes) {
+    ASSERT_EQ(evaluated, table.state(time, quat, av));
+    EXPECT_NEAR(0, av[0], 1e-12);
+    EXPECT_NEAR(0, av[1], 1e-12);
+    EXPECT_NEAR(-rate, av[2], 1e-12);
+  }
+
+  // Both conventions describe the same curve
+  double negatedQuat[4];
+  for (double time : {0.25, 0.5, 1.75}) {
+    ASSERT_EQ(evaluated, table.rotation(time, quat));
+    ASSERT_EQ(evaluated, negatedTable.rotation(time, negatedQuat));
+    for (int i = 0; i < 4; i++) {
+      EXPECT_NEAR(quat[i], negatedQuat[i], 1e-12);
+    }
+  }
+
+  // Between the times the rotation and rate are much closer than linear
+  double linearQuat[4];
+  double linearAv[3];
+  ASSERT_EQ(evaluated, table.state(0.5, quat, av));
+  ASSERT_EQ(evaluated, linearTable.state(0.5, linearQuat, linearAv));
+  double angle = 2 * atan2(quat[3], quat[0]);
+  double linearAngle = 2 * atan2(linearQuat[3], linearQuat[0]);
+  EXPECT_NEAR(M_PI / 4, angle, 1e-3);
+  EXPECT_LT(fabs(angle - M_PI / 4), fabs(linearAngle - M_PI / 4));
+  EXPECT_NEAR(-rate, av[2], 1e-2);
+  EXPECT_LT(fabs(av[2] + rate), fabs(linearAv[2] + rate));
+}
+
+TEST(RotationTableTest, HermiteQuaternionTable) {
+  const double rate = M_PI / 2;
+  QuaternionTable rotations(UniformTimeGrid(0, 1, 3),
+                            {{1, halfRoot2, 0}, {0, 0, 0}, {0, 0, 0}, {0, halfRoot2, 1}},
+                            {{0, 0, 0}, {0, 0, 0}, {rate, rate, rate}});
+  vector<double> avs = {0, 0, 0,
+                        0, 0, 0,
+                        rate, rate, rate};
+  RotationTable table(rotations, hermite);
+  RotationTable expected(MatrixView(zRotations.data(), 4, 3, 3, 1),
+                         MatrixView(avs.data(), 3, 3, 3, 1), rotationTimes);
+
+  double quat[4];
+  double expectedQuat[4];
+  ASSERT_EQ(evaluated, table.rotation(1.25, quat));
+  ASSERT_EQ(evaluated, expected.rotation(1.25, expectedQuat));
+  for (int i = 0; i < 4; i++) {
+    EXPECT_NEAR(expectedQuat[i], quat[i], 1e-12);
+  }
+
+  QuaternionTable noAvs(rotationTimes, {{1, halfRoot2, 0}, {0, 0, 0}, {0, 0, 0}, {0, halfRoot2, 1}});
+  EXPECT_THROW(RotationTable(noAvs, hermite), invalid_argument);
+  EXPECT_THROW(RotationTable(MatrixView(zRotations.data(), 4, 3, 3, 1),
+                             MatrixView(avs.data(), 3, 2, 2, 1), rotationTimes),
+               invalid_argument);
+}
+
+TEST(RotationTableTest, HermiteMatchesTimeDependentRotation) {
+  // A constant rate rotation about a tilted axis, sampled every 0.1 radians
+  vector<double> axis = {1, 2, 2};
+  vector<double> times;
+  vector<double> quaternions;
+  for (int i = 0; i < 11; i++) {
+    times.push_back(i);
+    double angle = 0.1 * i;
+    vector<double> quat = Rotation(axis, angle).toQuaternion();
+    quaternions.insert(quaternions.end(), quat.begin(), quat.end());
+  }
+  TimeDependentRotation samples(quaternions, times);
+
+  // Sample the rotation and its angular velocities straight from the TDR
+  vector<double> sampledQuats(4 * times.size());
+  vector<double> sampledAvs(3 * times.size());
+  samples.interpolate(times.data(), times.size(), sampledQuats.data(), sampledAvs.data());
+  RotationTable table(MatrixView(sampledQuats.data(), 4, times.size(), 1, 4),
+                      MatrixView(sampledAvs.data(), 3, times.size(), 1, 3), times);
+
+  // The midpoints alone cannot tell the conventions apart, the difference
+  // there is along the quaternion and normalizes away
+  for (size_t i = 0; i + 1 < times.size(); i++) {
+    for (double offset : {0.25, 0.5, 0.75}) {
+      double time = times[i] + offset;
+      double expected[4];
+      double quat[4];
+      samples.interpolate(&time, 1, expected, nullptr);
+      ASSERT_EQ(evaluated, table.rotation(time, quat));
+      double sign = (expected[0] * quat[0] + expected[1] * quat[1] +
+                     expected[2] * quat[2] + expected[3] * quat[3]) < 0 ? -1 : 1;
+      for (int j = 0; j < 4; j++) {
+        EXPECT_NEAR(expected[j], sign * quat[j], 1e-7);
+      }
+    }
+  }
+}
@@ -2,12 +2,40 @@
 
 #include "Rotation.h"
 
+#include <atomic>
 #include <cmath>
+#include <cstdlib>
 #include <exception>
+#include <new>
+#include <type_traits>
 
 using namespace std;
 using namespace ale;
 
+// Count heap allocations, so tests can check that a path makes none. The
+// replacements are kept out of line so the compiler does not see malloc and
+// free paired with new and delete expressions.
+#if defined(__GNUC__)
+#define ALE_TEST_NOINLINE __attribute__((noinline))
+#else
+#define ALE_TEST_NOINLINE
+#endif
+
+static atomic<size_t> allocationCount(0);
+
+ALE_TEST_NOINLINE void *operator new(size_t size) {
+  allocationCount++;
+  void *memory = malloc(size ? size : 1);
+  if (!memory) {
+    throw bad_alloc();
+  }
+  return memory;
+}
+
+ALE_TEST_NOINLINE void operator delete(void *memory) noexcept {
+  free(memory);
+}
+
 TEST(RotationTest, DefaultConstructor) {
   Rotation defaultRotation;
   vector<double> defaultQuat = defaultRotation.toQuaternion();
@@ -237,6 +265,107 @@ TEST(RotationTest, RotateVector) {
   EXPECT_NEAR(rotatedZ[2], 0.0, 1e-10);
 }
 
+TEST(RotationTest, ApplyVector) {
+  Rotation rotation(0.5, 0.5, 0.5, 0.5);
+  double vector[3] = {1.0, 2.0, 3.0};
+  double rotated[3];
+  rotation.apply(vector, rotated);
+  EXPECT_NEAR(rotated[0], 3.0, 1e-10);
+  EXPECT_NEAR(rotated[1], 1.0, 1e-10);
+  EXPECT_NEAR(rotated[2], 2.0, 1e-10);
+
+  // Rotate in place
+  rotation.apply(vector, vector);
+  EXPECT_NEAR(vector[0], 3.0, 1e-10);
+  EXPECT_NEAR(vector[1], 1.0, 1e-10);
+  EXPECT_NEAR(vector[2], 2.0, 1e-10);
+}
+
+TEST(RotationTest, ApplyVectors) {
+  Rotation rotation(0.5, 0.5, 0.5, 0.5);
+  vector<double> vectors = {1.0, 2.0, 3.0, -1.0, 0.5, 4.0, 0.0, 0.0, 1.0};
+  vector<double> rotated(vectors.size());
+  rotation.apply(vectors.data(), rotated.data(), 3);
+  for (size_t i = 0; i < 3; i++) {
+    vector<double> expected = rotation(vector<double>(vectors.begin() + 3 * i, vectors.begin() + 3 * i + 3));
+    for (size_t j = 0; j < 3; j++) {
+      EXPECT_NEAR(rotated[3 * i + j], expected[j], 1e-12);
+    }
+  }
+
+  // Rotate in place
+  rotation.apply(vectors.data(), vectors.data(), 3);
+  for (size_t i = 0; i < vectors.size(); i++) {
+    EXPECT_NEAR(vectors[i], rotated[i], 1e-12);
+  }
+}
+
+TEST(RotationTest, ApplyStates) {
+  Rotation rotation(0.5, 0.5, 0.5, 0.5);
+  vector<double> av = {0.1, -0.2, 0.3};
+  vector<double> states = {1.0, 2.0, 3.0, -1.0, 0.5, 4.0,
+                           0.0, 0.0, 1.0, 2.0, -3.0, 0.5};
+  vector<double> rotated(states.size());
+  rotation.applyState(states.data(), rotated.data(), 2, av.data());
+
+  vector<double> otherAv = {0.0, 1.0, 0.0};
+  vector<double> angularVelocities = {0.1, -0.2, 0.3, 0.0, 1.0, 0.0};
+  vector<double> series(states.size());
+  rotation.applyStateSeries(states.data(), angularVelocities.data(), series.data(), 2);
+
+  for (size_t i = 0; i < 2; i++) {
+    vector<double> state(states.begin() + 6 * i, states.begin() + 6 * i + 6);
+    vector<double> expected = rotation(state, av);
+    vector<double> expectedSeries = rotation(state, i == 0 ? av : otherAv);
+    for (size_t j = 0; j < 6; j++) {
+      EXPECT_NEAR(rotated[6 * i + j], expected[j], 1e-12);
+      EXPECT_NEAR(series[6 * i + j], expectedSeries[j], 1e-12);
+    }
+  }
+
+  // Without an angular velocity only the velocity is rotated
+  rotation.applyState(states.data(), states.data(), 2);
+  vector<double> velocity = rotation({-1.0, 0.5, 4.0});
+  EXPECT_NEAR(states[3], velocity[0], 1e-12);
+  EXPECT_NEAR(states[4], velocity[1], 1e-12);
+  EXPECT_NEAR(states[5], velocity[2], 1e-12);
+}
+
+TEST(RotationTest, ApplyChainWithoutAllocating) {
+  Rotation first(0.5, 0.5, 0.5, 0.5);
+  Rotation second(cos(0.3), 0.0, 0.0, sin(0.3));
+  Rotation third(cos(0.2), sin(0.2), 0.0, 0.0);
+  vector<double> av = {0.1, -0.2, 0.3};
+  vector<double> states = {1.0, 2.0, 3.0, -1.0, 0.5, 4.0,
+                           0.0, 0.0, 1.0, 2.0, -3.0, 0.5};
+  vector<double> rotated(states.size());
+  vector<double> rotatedStates(states.size());
+
+  // The chain folds into one inline Rotation, which is then applied to the
+  // whole batch in one pass
+  size_t before = allocationCount;
+  (first * second * third).apply(states.data(), rotated.data(), 4);
+  (first * second * third).applyState(states.data(), rotatedStates.data(), 2, av.data());
+  size_t allocations = allocationCount - before;
+  EXPECT_EQ(0, allocations);
+
+  // Same as applying each rotation in turn
+  vector<double> expected(states.size());
+  third.apply(states.data(), expected.data(), 4);
+  second.apply(expected.data(), expected.data(), 4);
+  first.apply(expected.data(), expected.data(), 4);
+  for (size_t i = 0; i < states.size(); i++) {
+    EXPECT_NEAR(expected[i], rotated[i], 1e-12);
+  }
+  Rotation chained = first * second * third;
+  for (size_t i = 0; i < 2; i++) {
+    vector<double> expectedState = chained(vector<double>(states.begin() + 6 * i, states.begin() + 6 * i + 6), av);
+    for (size_t j = 0; j < 6; j++) {
+      EXPECT_NEAR(expectedState[j], rotatedStates[6 * i + j], 1e-12);
+    }
+  }
+}
+
 TEST(RotationTest, RotateState) {
   Rotation rotation(0.5, 0.5, 0.5, 0.5);
   std::vector<double> av = {2.0 / 3.0 * M_PI, 2.0 / 3.0 * M_PI, 2.0 / 3.0 * M_PI};
@@ -411,6 +540,49 @@ TEST(RotationTest, SlerpExtrapolate) {
   EXPECT_NEAR(quat[3], sin(M_PI * 17.0/24.0) * 1/sqrt(3.0), 1e-10);
 }
 
+TEST(RotationTest, FastSlerp) {
+  // The bound on the angle between fastSlerp and slerp for each separation
+  vector<double> separations = {0.01, 0.5, 1.0};
+  vector<double> bounds = {1e-12, 1e-12, 1e-8};
+  for (size_t k = 0; k < separations.size(); k++) {
+    Rotation rotationOne(0.5, 0.5, 0.5, 0.5);
+    Rotation step(vector<double>({0.6, 0.0, 0.8}), separations[k]);
+    Rotation rotationTwo = step * rotationOne;
+    vector<double> t = {0.0, 0.1, 0.25, 0.5, 0.75, 0.9, 1.0};
+    vector<double> quats(4 * t.size());
+    rotationOne.interpolate(rotationTwo, t.data(), t.size(), quats.data(), ale::fastSlerp);
+    for (size_t i = 0; i < t.size(); i++) {
+      vector<double> expected = rotationOne.interpolate(rotationTwo, t[i], ale::slerp).toQuaternion();
+      vector<double> single = rotationOne.interpolate(rotationTwo, t[i], ale::fastSlerp).toQuaternion();
+      // For nearby unit quaternions, the angle between them is twice their distance
+      double distance = 0;
+      for (size_t j = 0; j < 4; j++) {
+        distance += pow(expected[j] - quats[4 * i + j], 2);
+        EXPECT_DOUBLE_EQ(single[j], quats[4 * i + j]);
+      }
+      EXPECT_LT(2 * sqrt(distance), bounds[k]);
+    }
+  }
+}
+
+TEST(RotationTest, InterpolateBatch) {
+  Rotation rotationOne(0.5, 0.5, 0.5, 0.5);
+  Rotation rotationTwo(-0.5, 0.5, 0.5, 0.5);
+  vector<double> t = {0.125, 0.5, 1.125};
+  vector<double> quats(4 * t.size());
+  for (RotationInterpolation interpType : {ale::slerp, ale::nlerp}) {
+    rotationOne.interpolate(rotationTwo, t.data(), t.size(), quats.data(), interpType);
+    for (size_t i = 0; i < t.size(); i++) {
+      vector<double> expected = rotationOne.interpolate(rotationTwo, t[i], interpType).toQuaternion();
+      for (size_t j = 0; j < 4; j++) {
+        EXPECT_EQ(expected[j], quats[4 * i + j]);
+      }
+    }
+  }
+  EXPECT_THROW(rotationOne.interpolate(rotationTwo, t.data(), t.size(), quats.data(), ale::squad),
+               invalid_argument);
+}
+
 TEST(RotationTest, Nlerp) {
   Rotation rotationOne(0.5, 0.5, 0.5, 0.5);
   Rotation rotationTwo(-0.5, 0.5, 0.5, 0.5);
@@ -436,3 +608,99 @@ TEST(RotationTest, NlerpExtrapolate) {
   EXPECT_NEAR(quat[2], 1.0 / 2.0 * scaling, 1e-10);
   EXPECT_NEAR(quat[3], 1.0 / 2.0 * scaling, 1e-10);
 }
+
+TEST(RotationTest, SquadNeedsSeries) {
+  Rotation rotationOne(0.5, 0.5, 0.5, 0.5);
+  Rotation rotationTwo(-0.5, 0.5, 0.5, 0.5);
+  EXPECT_THROW(rotationOne.interpolate(rotationTwo, 0.5, ale::squad), invalid_argument);
+}
+
+TEST(RotationTest, InlineStorage) {
+  EXPECT_TRUE(is_trivially_copyable<Rotation>::value);
+  EXPECT_EQ(sizeof(Rotation), 4 * sizeof(double));
+
+  vector<Rotation> rotations(3, Rotation(0.5, 0.5, 0.5, 0.5));
+  Rotation chained;
+  for (const Rotation &rotation : rotations) {
+    chained = rotation * chained;
+  }
+  vector<double> quat = chained.toQuaternion();
+  EXPECT_NEAR(fabs(quat[0]), 1.0, 1e-10);
+}
+
+TEST(RotationTest, BufferAccessors) {
+  Rotation rotation(0.5, -0.5, 0.5, 0.5);
+
+  double quat[4];
+  rotation.toQuaternion(quat);
+  vector<double> quatVector = rotation.toQuaternion();
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(quatVector[i], quat[i]);
+  }
+
+  double mat[9];
+  rotation.toRotationMatrix(mat);
+  vector<double> matVector = rotation.toRotationMatrix();
+  for (int i = 0; i < 9; i++) {
+    EXPECT_EQ(matVector[i], mat[i]);
+  }
+
+  double av[3] = {1, 2, 3};
+  double stateMat[36];
+  rotation.toStateRotationMatrix(av, stateMat);
+  vector<double> stateMatVector = rotation.toStateRotationMatrix({1, 2, 3});
+  for (int i = 0; i < 36; i++) {
+    EXPECT_EQ(stateMatVector[i], stateMat[i]);
+  }
+
+  double angles[3];
+  rotation.toEuler({{2, 1, 0}}, angles);
+  vector<double> anglesVector = rotation.toEuler({2, 1, 0});
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(anglesVector[i], angles[i]);
+  }
+  EXPECT_THROW(rotation.toEuler({{0, 1, 3}}, angles), invalid_argument);
+
+  double axis[3];
+  double angle = rotation.toAxisAngle(axis);
+  std::pair<vector<double>, double> axisAngle = rotation.toAxisAngle();
+  EXPECT_EQ(axisAngle.second, angle);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(axisAngle.first[i], axis[i]);
+  }
+}
+
+TEST(RotationTest, PreparedRotation) {
+  Rotation rotation(0.5, -0.5, 0.5, 0.5);
+  double av[3] = {1, 2, 3};
+  PreparedRotation prepared(rotation, av);
+
+  vector<double> mat = rotation.toRotationMatrix();
+  for (int i = 0; i < 9; i++) {
+    EXPECT_EQ(mat[i], prepared.rotationMatrix()[i]);
+  }
+
+  double stateMat[36];
+  prepared.toStateRotationMatrix(stateMat);
+  vector<double> expectedStateMat = rotation.toStateRotationMatrix({1, 2, 3});
+  for (int i = 0; i < 36; i++) {
+    EXPECT_EQ(expectedStateMat[i], stateMat[i]);
+  }
+
+  vector<double> state = {1, 2, 3, -1, -2, -3};
+  vector<double> rotatedState = prepared(state);
+  vector<double> expectedState = rotation(state, {1, 2, 3});
+  ASSERT_EQ(rotatedState.size(), 6);
+  for (int i = 0; i < 6; i++) {
+    EXPECT_NEAR(expectedState[i], rotatedState[i], 1e-12);
+  }
+
+  vector<double> position = prepared({1, 2, 3});
+  vector<double> expectedPosition = rotation({1, 2, 3});
+  ASSERT_EQ(position.size(), 3);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(expectedPosition[i], position[i], 1e-12);
+  }
+
+  EXPECT_THROW(prepared({1, 2}), invalid_argument);
+}
@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+
+#include "StateInterpolator.h"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace ale;
+
+// x = t^3, y = t^2, z = t
+static const vector<double> stateTimes = {-2, -1, 0, 1, 2};
+static const vector<vector<double>> statePositions = {{-8, -1, 0, 1, 8},
+                                                      { 4,  1, 0, 1, 4},
+                                                      {-2, -1, 0, 1, 2}};
+static const vector<vector<double>> stateVelocities = {{12, 3, 0, 3, 12},
+                                                       {-4, -2, 0, 2, 4},
+                                                       { 1, 1, 1, 1, 1}};
+
+TEST(StateInterpolatorTest, Hermite) {
+  StateTable states(stateTimes, statePositions, stateVelocities);
+  StateInterpolator interpolator(states, hermite);
+
+  double position[3];
+  double velocity[3];
+  ASSERT_EQ(evaluated, interpolator.state(-1.5, position, velocity));
+  EXPECT_NEAR(-3.375, position[0], 1e-12);
+  EXPECT_NEAR(2.25, position[1], 1e-12);
+  EXPECT_NEAR(-1.5, position[2], 1e-12);
+  EXPECT_NEAR(6.75, velocity[0], 1e-12);
+  EXPECT_NEAR(-3.0, velocity[1], 1e-12);
+  EXPECT_NEAR(1.0, velocity[2], 1e-12);
+
+  ASSERT_EQ(evaluated, interpolator.velocity(0.5, velocity));
+  EXPECT_NEAR(0.75, velocity[0], 1e-12);
+  EXPECT_EQ(outOfRange, interpolator.position(2.1, position));
+}
+
+TEST(StateInterpolatorTest, Extrapolation) {
+  StateTable states(stateTimes, statePositions);
+  StateInterpolator clampInterpolator(states, linear, clampToEnds);
+  StateInterpolator extrapolateInterpolator(states, linear, extrapolateEnds);
+
+  double position[3];
+  EXPECT_EQ(clamped, clampInterpolator.position(2.5, position));
+  EXPECT_DOUBLE_EQ(8, position[0]);
+  EXPECT_DOUBLE_EQ(4, position[1]);
+  EXPECT_DOUBLE_EQ(2, position[2]);
+
+  EXPECT_EQ(extrapolated, extrapolateInterpolator.position(2.5, position));
+  EXPECT_DOUBLE_EQ(11.5, position[0]);
+  EXPECT_DOUBLE_EQ(5.5, position[1]);
+  EXPECT_DOUBLE_EQ(2.5, position[2]);
+
+  vector<double> times = {-1.5, 0.5, 3.0};
+  vector<double> positions(3 * times.size());
+  vector<double> velocities(3 * times.size());
+  EXPECT_EQ(extrapolated, extrapolateInterpolator.states(times.data(), times.size(),
+                                                         positions.data(), velocities.data()));
+  EXPECT_DOUBLE_EQ(-4.5, positions[0]);
+  EXPECT_DOUBLE_EQ(0.5, positions[3]);
+  EXPECT_DOUBLE_EQ(15.0, positions[6]);
+  EXPECT_DOUBLE_EQ(7.0, velocities[6]);
+}
+
+TEST(StateInterpolatorTest, View) {
+  vector<double> flatPositions = {-8, -1, 0, 1, 8,
+                                   4,  1, 0, 1, 4,
+                                  -2, -1, 0, 1, 2};
+  MatrixView positionView(flatPositions.data(), 3, 5, 5, 1);
+  StateInterpolator interpolator(positionView, UniformTimeGrid(-2, 1, 5), spline);
+  StateInterpolator expected(positionView, stateTimes, spline);
+
+  double position[3];
+  double expectedPosition[3];
+  ASSERT_EQ(evaluated, interpolator.position(0.25, position));
+  ASSERT_EQ(evaluated, expected.position(0.25, expectedPosition));
+  for (int axis = 0; axis < 3; axis++) {
+    EXPECT_NEAR(expectedPosition[axis], position[axis], 1e-12);
+  }
+}
+
+TEST(StateInterpolatorTest, BadInput) {
+  StateTable states(stateTimes, statePositions);
+  EXPECT_THROW(StateInterpolator(states, hermite), invalid_argument);
+
+  vector<double> flatPositions = {0, 1, 0, 1};
+  vector<double> times = {0, 1};
+  vector<double> singleTime = {0};
+  EXPECT_THROW(StateInterpolator(MatrixView(flatPositions.data(), 2, 2, 2, 1),
+                                 times, linear),
+               invalid_argument);
+  EXPECT_THROW(StateInterpolator(MatrixView(flatPositions.data(), 3, 1, 1, 1),
+                                 singleTime, linear),
+               invalid_argument);
+}
@@ -0,0 +1,165 @@
+#include "gtest/gtest.h"
+
+#include "Tables.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace ale;
+
+TEST(StateTableTest, Constructor) {
+  vector<double> times = {0, 1, 2};
+  vector<vector<double>> positions = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+  vector<vector<double>> velocities = {{-1, -2, -3}, {-4, -5, -6}, {-7, -8, -9}};
+  StateTable states(times, positions, velocities);
+
+  ASSERT_EQ(states.size(), 3);
+  ASSERT_TRUE(states.hasVelocities());
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_EQ(states.times()[i], times[i]);
+    for (int axis = 0; axis < 3; axis++) {
+      EXPECT_EQ(states.positions(axis)[i], positions[axis][i]);
+      EXPECT_EQ(states.velocities(axis)[i], velocities[axis][i]);
+      EXPECT_EQ(states.positionsView()(axis, i), positions[axis][i]);
+      EXPECT_EQ(states.velocitiesView()(axis, i), velocities[axis][i]);
+    }
+  }
+}
+
+TEST(StateTableTest, NoVelocities) {
+  vector<double> times = {0, 1, 2};
+  vector<vector<double>> positions = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+  StateTable states(times, positions);
+
+  ASSERT_EQ(states.size(), 3);
+  EXPECT_FALSE(states.hasVelocities());
+  EXPECT_EQ(states.positions(2)[1], 8);
+  for (int axis = 0; axis < 3; axis++) {
+    EXPECT_EQ(states.velocities(axis), nullptr);
+  }
+
+  const StateTable &constStates = states;
+  EXPECT_EQ(constStates.velocities(2), nullptr);
+}
+
+TEST(StateTableTest, AlignedColumns) {
+  StateTable states(5);
+  double *columns[] = {states.times(),
+                       states.positions(0), states.positions(1), states.positions(2),
+                       states.velocities(0), states.velocities(1), states.velocities(2)};
+  for (double *column : columns) {
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(column) % 64, 0);
+  }
+  // Each column is contiguous and zero filled
+  EXPECT_EQ(states.positionsView().component(1).stride(), 1);
+  EXPECT_EQ(states.positions(1)[4], 0.0);
+}
+
+TEST(StateTableTest, FillInPlace) {
+  StateTable states(2, false);
+  states.times()[0] = 0;
+  states.times()[1] = 1;
+  states.positions(0)[1] = 3;
+
+  EXPECT_EQ(states.timesView().back(), 1);
+  EXPECT_EQ(states.positionsView()(0, 1), 3);
+}
+
+TEST(StateTableTest, Copy) {
+  vector<double> times = {0, 1};
+  vector<vector<double>> positions = {{1, 2}, {3, 4}, {5, 6}};
+  StateTable states(times, positions);
+  StateTable copied(states);
+  states.positions(0)[0] = 10;
+
+  EXPECT_EQ(copied.positions(0)[0], 1);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(copied.positions(2)) % 64, 0);
+}
+
+TEST(StateTableTest, BadInput) {
+  vector<double> times = {0, 1};
+  EXPECT_THROW(StateTable(times, {{1, 2}, {3, 4}}), invalid_argument);
+  EXPECT_THROW(StateTable(times, {{1, 2}, {3, 4}, {5}}), invalid_argument);
+  EXPECT_THROW(StateTable(times, {{1, 2}, {3, 4}, {5, 6}}, {{1, 2}}), invalid_argument);
+}
+
+TEST(StateTableTest, UniformTimeGrid) {
+  vector<vector<double>> positions = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+  StateTable states(UniformTimeGrid(10, 0.5, 3), positions);
+
+  ASSERT_EQ(states.size(), 3);
+  ASSERT_TRUE(states.isUniform());
+  EXPECT_FALSE(states.hasVelocities());
+  EXPECT_DOUBLE_EQ(states.grid()[2], 11);
+  for (size_t i = 0; i < 3; i++) {
+    for (int axis = 0; axis < 3; axis++) {
+      EXPECT_EQ(states.positions(axis)[i], positions[axis][i]);
+    }
+  }
+
+  // Only the positions are stored
+  StateTable empty(UniformTimeGrid(0, 1, 100), false);
+  EXPECT_EQ(empty.positions(1) - empty.positions(0), empty.positions(2) - empty.positions(1));
+  EXPECT_FALSE(StateTable(vector<double>{0, 1}, {{0, 1}, {0, 1}, {0, 1}}).isUniform());
+
+  // No times are stored, so there is nothing to point at
+  EXPECT_EQ(states.times(), nullptr);
+  EXPECT_EQ(states.timesView().size(), 0);
+}
+
+TEST(QuaternionTableTest, Constructor) {
+  vector<double> times = {0, 1};
+  vector<vector<double>> quats = {{1, 0}, {0, 1}, {0, 0}, {0, 0}};
+  vector<vector<double>> avs = {{1, 2}, {3, 4}, {5, 6}};
+  QuaternionTable rotations(times, quats, avs);
+
+  ASSERT_EQ(rotations.size(), 2);
+  ASSERT_TRUE(rotations.hasAngularVelocities());
+  for (size_t i = 0; i < 2; i++) {
+    for (int component = 0; component < 4; component++) {
+      EXPECT_EQ(rotations.quaternions(component)[i], quats[component][i]);
+      EXPECT_EQ(rotations.quaternionsView()(component, i), quats[component][i]);
+    }
+    for (int axis = 0; axis < 3; axis++) {
+      EXPECT_EQ(rotations.angularVelocities(axis)[i], avs[axis][i]);
+    }
+  }
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(rotations.angularVelocities(2)) % 64, 0);
+}
+
+TEST(QuaternionTableTest, UniformTimeGrid) {
+  vector<vector<double>> quats = {{1, 0}, {0, 1}, {0, 0}, {0, 0}};
+  QuaternionTable rotations(UniformTimeGrid(0, 2, 2), quats);
+
+  ASSERT_EQ(rotations.size(), 2);
+  ASSERT_TRUE(rotations.isUniform());
+  EXPECT_DOUBLE_EQ(rotations.grid().back(), 2);
+  for (size_t i = 0; i < 2; i++) {
+    for (int component = 0; component < 4; component++) {
+      EXPECT_EQ(rotations.quaternionsView()(component, i), quats[component][i]);
+    }
+  }
+  EXPECT_EQ(rotations.times(), nullptr);
+  EXPECT_EQ(rotations.timesView().size(), 0);
+  EXPECT_THROW(QuaternionTable(UniformTimeGrid(0, 1, 3), quats), invalid_argument);
+}
+
+TEST(QuaternionTableTest, BadInput) {
+  vector<double> times = {0, 1};
+  EXPECT_THROW(QuaternionTable(times, {{1, 0}, {0, 1}, {0, 0}}), invalid_argument);
+  EXPECT_THROW(QuaternionTable(times, {{1, 0}, {0, 1}, {0, 0}, {0, 0}}, {{1, 2}, {3, 4}}),
+               invalid_argument);
+}
+
+TEST(QuaternionTableTest, NoAngularVelocities) {
+  QuaternionTable rotations({0, 1}, {{1, 0}, {0, 1}, {0, 0}, {0, 0}});
+  EXPECT_FALSE(rotations.hasAngularVelocities());
+  for (int axis = 0; axis < 3; axis++) {
+    EXPECT_EQ(rotations.angularVelocities(axis), nullptr);
+  }
+
+  const QuaternionTable uniform(UniformTimeGrid(0, 1, 2));
+  EXPECT_EQ(uniform.angularVelocities(2), nullptr);
+}
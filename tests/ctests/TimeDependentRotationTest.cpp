@@ -0,0 +1,207 @@
+#include "gtest/gtest.h"
+
+#include "Rotation.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace ale;
+
+static const double halfRoot2 = sqrt(0.5);
+
+// The quaternion for a rotation about X
+static vector<double> xRotation(double degrees) {
+  double halfAngle = degrees * M_PI / 360;
+  return {cos(halfAngle), sin(halfAngle), 0, 0};
+}
+
+// q and -q are the same rotation
+static void expectSameRotation(const vector<double> &expected, const double *quat) {
+  double sign = expected[0] * quat[0] + expected[1] * quat[1] +
+                expected[2] * quat[2] + expected[3] * quat[3] < 0 ? -1 : 1;
+  for (int i = 0; i < 4; i++) {
+    EXPECT_NEAR(expected[i], sign * quat[i], 1e-10);
+  }
+}
+
+TEST(TimeDependentRotationTest, Slerp) {
+  vector<double> quats;
+  for (double angle : {-135, -90, 0, 45, 90}) {
+    vector<double> quat = xRotation(angle);
+    quats.insert(quats.end(), quat.begin(), quat.end());
+  }
+  TimeDependentRotation rotation(quats, {-0.5, 0, 1, 1.5, 2});
+  ASSERT_EQ(rotation.size(), 5);
+  EXPECT_FALSE(rotation.hasAngularVelocities());
+
+  vector<double> times = {-3, -2, -1, 0, 1, 2, 3, 4};
+  vector<double> newQuats(4 * times.size());
+  vector<double> newAvs(3 * times.size());
+  rotation.interpolate(times.data(), times.size(), newQuats.data(), newAvs.data());
+  for (size_t i = 0; i < times.size(); i++) {
+    expectSameRotation(xRotation(90 * times[i] - 90), &newQuats[4 * i]);
+    EXPECT_NEAR(M_PI / 2, newAvs[3 * i], 1e-10);
+    EXPECT_NEAR(0, newAvs[3 * i + 1], 1e-10);
+    EXPECT_NEAR(0, newAvs[3 * i + 2], 1e-10);
+  }
+}
+
+TEST(TimeDependentRotationTest, SingleTime) {
+  TimeDependentRotation constant({1, 0, 0, 0}, {0});
+  TimeDependentRotation turning({1, 0, 0, 0}, {0}, {M_PI / 2, 0, 0});
+
+  vector<double> times = {-1, 3};
+  vector<double> quats(8);
+  vector<double> avs(6);
+  constant.interpolate(times.data(), times.size(), quats.data(), avs.data());
+  for (size_t i = 0; i < times.size(); i++) {
+    expectSameRotation({1, 0, 0, 0}, &quats[4 * i]);
+    EXPECT_EQ(0, avs[3 * i]);
+  }
+
+  turning.interpolate(times.data(), times.size(), quats.data(), avs.data());
+  expectSameRotation({halfRoot2, -halfRoot2, 0, 0}, &quats[0]);
+  expectSameRotation({-halfRoot2, halfRoot2, 0, 0}, &quats[4]);
+  EXPECT_EQ(M_PI / 2, avs[0]);
+  EXPECT_EQ(M_PI / 2, avs[3]);
+}
+
+TEST(TimeDependentRotationTest, VariableAngularVelocity) {
+  // The stored angular velocities are linearly interpolated
+  TimeDependentRotation rotation({1, 0, 0, 0, 1, 0, 0, 0}, {0, 2}, {0, 0, 0, 0, 0, 4});
+  TimeDependentRotation resampled = rotation.reinterpolate({-1, 1, 3});
+  ASSERT_EQ(resampled.size(), 3);
+  ASSERT_TRUE(resampled.hasAngularVelocities());
+  const vector<double> &avs = resampled.angularVelocities();
+  EXPECT_NEAR(-2, avs[2], 1e-12);
+  EXPECT_NEAR(2, avs[5], 1e-12);
+  EXPECT_NEAR(6, avs[8], 1e-12);
+  EXPECT_EQ(resampled.times(), vector<double>({-1, 1, 3}));
+}
+
+TEST(TimeDependentRotationTest, Inverse) {
+  TimeDependentRotation rotation({halfRoot2, halfRoot2, 0, 0, 0, 1, 0, 0}, {0, 1},
+                                 {M_PI / 2, 0, 0, M_PI / 2, 0, 0});
+  TimeDependentRotation inverse = rotation.inverse();
+  expectSameRotation({halfRoot2, -halfRoot2, 0, 0}, &inverse.quaternions()[0]);
+  expectSameRotation({0, 1, 0, 0}, &inverse.quaternions()[4]);
+  EXPECT_EQ(inverse.times(), rotation.times());
+  EXPECT_NEAR(-M_PI / 2, inverse.angularVelocities()[0], 1e-12);
+  EXPECT_NEAR(-M_PI / 2, inverse.angularVelocities()[3], 1e-12);
+
+  TimeDependentRotation noAvs({halfRoot2, halfRoot2, 0, 0, 0, 1, 0, 0}, {0, 1});
+  EXPECT_FALSE(noAvs.inverse().hasAngularVelocities());
+}
+
+TEST(TimeDependentRotationTest, ConstantComposition) {
+  vector<double> quats = {halfRoot2, halfRoot2, 0, 0, 0, 1, 0, 0};
+  vector<double> avs = {M_PI / 2, 0, 0, M_PI / 2, 0, 0};
+  TimeDependentRotation rotation(quats, {0, 1}, avs);
+
+  TimeDependentRotation left = Rotation(halfRoot2, 0, halfRoot2, 0) * rotation;
+  expectSameRotation({0.5, 0.5, 0.5, -0.5}, &left.quaternions()[0]);
+  expectSameRotation({0, halfRoot2, 0, -halfRoot2}, &left.quaternions()[4]);
+  for (size_t i = 0; i < avs.size(); i++) {
+    EXPECT_NEAR(avs[i], left.angularVelocities()[i], 1e-12);
+  }
+
+  TimeDependentRotation right = rotation * Rotation(halfRoot2, halfRoot2, 0, 0);
+  expectSameRotation({0, 1, 0, 0}, &right.quaternions()[0]);
+  expectSameRotation({-halfRoot2, halfRoot2, 0, 0}, &right.quaternions()[4]);
+  for (size_t i = 0; i < avs.size(); i++) {
+    EXPECT_NEAR(avs[i], right.angularVelocities()[i], 1e-12);
+  }
+}
+
+TEST(TimeDependentRotationTest, Composition) {
+  // 90 to 180 degrees about X and -90 to 90 degrees about X
+  TimeDependentRotation rotation1_2({halfRoot2, halfRoot2, 0, 0, 0, 1, 0, 0}, {0, 1},
+                                    {M_PI / 2, 0, 0, M_PI / 2, 0, 0});
+  TimeDependentRotation rotation2_3({halfRoot2, -halfRoot2, 0, 0, halfRoot2, halfRoot2, 0, 0}, {0, 2},
+                                    {M_PI / 2, 0, 0, M_PI / 2, 0, 0});
+
+  TimeDependentRotation rotation1_3 = rotation2_3 * rotation1_2;
+  ASSERT_EQ(rotation1_3.times(), vector<double>({0, 1, 2}));
+  expectSameRotation({1, 0, 0, 0}, &rotation1_3.quaternions()[0]);
+  expectSameRotation({0, 1, 0, 0}, &rotation1_3.quaternions()[4]);
+  expectSameRotation({1, 0, 0, 0}, &rotation1_3.quaternions()[8]);
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_NEAR(M_PI, rotation1_3.angularVelocities()[3 * i], 1e-10);
+    EXPECT_NEAR(0, rotation1_3.angularVelocities()[3 * i + 1], 1e-10);
+    EXPECT_NEAR(0, rotation1_3.angularVelocities()[3 * i + 2], 1e-10);
+  }
+}
+
+TEST(TimeDependentRotationTest, ComposeOnTimes) {
+  TimeDependentRotation rotation1_2({halfRoot2, halfRoot2, 0, 0, 0, 1, 0, 0}, {0, 1},
+                                    {M_PI / 2, 0, 0, M_PI / 2, 0, 0});
+  TimeDependentRotation rotation2_3({halfRoot2, -halfRoot2, 0, 0, halfRoot2, halfRoot2, 0, 0}, {0, 2});
+
+  vector<double> times = {-0.5, 0.25, 0.5, 1.5, 3};
+  TimeDependentRotation rotation1_3 = rotation2_3.compose(rotation1_2, times);
+  TimeDependentRotation merged = (rotation2_3 * rotation1_2).reinterpolate(times);
+  ASSERT_EQ(rotation1_3.times(), times);
+  for (size_t i = 0; i < times.size(); i++) {
+    expectSameRotation(xRotation(180 * times[i]), &rotation1_3.quaternions()[4 * i]);
+    expectSameRotation(vector<double>(merged.quaternions().begin() + 4 * i,
+                                      merged.quaternions().begin() + 4 * i + 4),
+                       &rotation1_3.quaternions()[4 * i]);
+    EXPECT_NEAR(M_PI, rotation1_3.angularVelocities()[3 * i], 1e-10);
+  }
+}
+
+TEST(TimeDependentRotationTest, Apply) {
+  vector<double> quats;
+  for (double angle : {-90, 0, 45}) {
+    vector<double> quat = xRotation(angle);
+    quats.insert(quats.end(), quat.begin(), quat.end());
+  }
+  TimeDependentRotation rotation(quats, {0, 1, 1.5});
+
+  vector<double> positions = {1, 2, 3, 1, 2, 3};
+  vector<double> times = {0, 2};
+  rotation.apply(positions.data(), times.data(), times.size(), positions.data());
+  vector<double> expected = {1, 3, -2, 1, -3, 2};
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_NEAR(expected[i], positions[i], 1e-10);
+  }
+}
+
+TEST(TimeDependentRotationTest, ApplyState) {
+  // X by -90 degrees, then Y by 180 degrees, then Z by 90 degrees
+  vector<double> quats = {1, 0, 0, 0};
+  vector<Rotation> rotations = {Rotation(vector<double>({-M_PI / 2}), vector<int>({0})),
+                                Rotation(vector<double>({M_PI, -M_PI / 2}), vector<int>({1, 0})),
+                                Rotation(vector<double>({M_PI / 2, M_PI, -M_PI / 2}), vector<int>({2, 1, 0}))};
+  for (const Rotation &step : rotations) {
+    vector<double> quat = step.toQuaternion();
+    quats.insert(quats.end(), quat.begin(), quat.end());
+  }
+  TimeDependentRotation rotation(quats, {0, 1, 2, 3});
+
+  vector<double> positions = {1, 2, 3, 1, 2, 3, 1, 2, 3};
+  vector<double> velocities = {-1, -2, -3, -1, -2, -3, -1, -2, -3};
+  vector<double> times = {1, 2, 3};
+  vector<double> rotatedPositions(9);
+  vector<double> rotatedVelocities(9);
+  rotation.applyState(positions.data(), velocities.data(), times.data(), times.size(),
+                      rotatedPositions.data(), rotatedVelocities.data());
+  vector<double> expected = {-1, -3 + M_PI, 2 + 3 * M_PI / 2,
+                             1 + 3 * M_PI, -3 + M_PI, -2,
+                             3, 1 - M_PI, -2 - M_PI / 2};
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_NEAR(expected[i], rotatedVelocities[i], 1e-10);
+  }
+  EXPECT_NEAR(1, rotatedPositions[0], 1e-10);
+  EXPECT_NEAR(3, rotatedPositions[1], 1e-10);
+  EXPECT_NEAR(-2, rotatedPositions[2], 1e-10);
+}
+
+TEST(TimeDependentRotationTest, BadInput) {
+  EXPECT_THROW(TimeDependentRotation({}, {}), invalid_argument);
+  EXPECT_THROW(TimeDependentRotation({1, 0, 0}, {0}), invalid_argument);
+  EXPECT_THROW(TimeDependentRotation({1, 0, 0, 0}, {0}, {1, 0}), invalid_argument);
+  EXPECT_THROW(TimeDependentRotation({1, 0, 0, 0, 1, 0, 0, 0}, {1, 1}), invalid_argument);
+}
@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+
+#include "IntervalCursor.h"
+#include "UniformTimeGrid.h"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace ale;
+
+TEST(UniformTimeGridTest, Times) {
+  UniformTimeGrid grid(-1, 0.25, 9);
+  ASSERT_EQ(grid.size(), 9);
+  EXPECT_DOUBLE_EQ(grid.front(), -1);
+  EXPECT_DOUBLE_EQ(grid[4], 0);
+  EXPECT_DOUBLE_EQ(grid.back(), 1);
+}
+
+TEST(UniformTimeGridTest, MatchesSearch) {
+  UniformTimeGrid grid(10, 0.5, 8);
+  vector<double> times(grid.size());
+  for (size_t i = 0; i < grid.size(); i++) {
+    times[i] = grid[i];
+  }
+
+  IntervalCursor cursor;
+  for (double t : {9.0, 10.0, 10.2, 10.5, 11.9, 12.0, 13.25, 13.5, 14.0}) {
+    EXPECT_EQ(cursor.find(times.data(), times.size(), t), grid.interval(t)) << t;
+  }
+}
+
+TEST(UniformTimeGridTest, BadInput) {
+  EXPECT_THROW(UniformTimeGrid(0, 0, 5), invalid_argument);
+  EXPECT_THROW(UniformTimeGrid(0, -1, 5), invalid_argument);
+}